@@ -0,0 +1,128 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// ColorPipeline.cpp
+
+#include "ColorPipeline.h"
+#include "OscManager.h"
+#include <algorithm>
+#include <string>
+
+ColorPipeline::ColorPipeline(UserSettings& settings, ColorProcessor& colorProcessor, OscManager& oscManager)
+    : settings(settings), colorProcessor(colorProcessor), oscManager(oscManager),
+    currentColor{ 0, 0, 0 }, targetColor{ 0, 0, 0 } {
+}
+
+void ColorPipeline::ProcessFrame(const Bitmap& frame, const PixelRect& crop, bool keepFrame) {
+    bool useCrop = crop.right > crop.left && crop.bottom > crop.top;
+    bool useZones = settings.zoneColumns * settings.zoneRows > 1;
+
+    // Full frame, or a zero-copy view of the crop
+    BitmapView processingView = useCrop ? frame.SubView(crop) : BitmapView(frame);
+    if (!processingView.IsValid()) {
+        processingView = frame;
+    }
+
+    // The colour is always the downscaled average of the crop, with or without zones, so the
+    // same crop sends the same colour whatever else is enabled
+    auto avgColor = colorProcessor.GetDownscaledAverageColor(processingView);
+
+    // Store the target color (before smoothing)
+    targetColor = colorProcessor.ProcessColor(avgColor);
+
+    // Zones inside a crop are answered from an integral image built once per frame, without a
+    // crop all zones come from a single pass over the frame
+    bool useIntegral = useCrop && useZones;
+    if (useIntegral) {
+        frameIntegral.Build(frame);
+        colorProcessor.GetZoneAverageColors(frameIntegral, crop, settings.zoneColumns, settings.zoneRows, zoneAverageColors);
+    }
+    else {
+        if (frameIntegral.IsValid()) {
+            frameIntegral.Clear();
+        }
+        if (useZones) {
+            colorProcessor.GetZoneAverageColors(processingView, settings.zoneColumns, settings.zoneRows, zoneAverageColors);
+        }
+    }
+
+    // Holding the frame keeps its buffer out of the pool, so only while it is needed
+    selectionFrame = keepFrame ? frame : Bitmap();
+
+    if (useZones) {
+        colorProcessor.ProcessZoneColors(zoneAverageColors, zoneTargetColors);
+    }
+    else {
+        zoneTargetColors.clear();
+    }
+}
+
+void ColorPipeline::UpdateSelectionColor(const PixelRect& selection) {
+    if (!selectionFrame.IsValid() ||
+        selection.right <= selection.left ||
+        selection.bottom <= selection.top) {
+        return;
+    }
+
+    BitmapView selectionView = selectionFrame.SubView(selection);
+    if (!selectionView.IsValid()) {
+        return;
+    }
+
+    targetColor = colorProcessor.ProcessColor(colorProcessor.GetDownscaledAverageColor(selectionView));
+}
+
+void ColorPipeline::UpdateSmoothing(float deltaTime) {
+    if (settings.enableSmoothing) {
+        currentColor = colorProcessor.GetSmoothedColor(deltaTime, targetColor);
+    }
+    else {
+        currentColor = targetColor;
+    }
+}
+
+void ColorPipeline::SendOsc() {
+    // Current color (smoothed or direct), followed by the zone colors when a grid is set up
+    oscValues.assign({ currentColor.r, currentColor.g, currentColor.b });
+
+    if (!zoneTargetColors.empty()) {
+        // Registering is only needed when the grid grows, zones keep their IDs
+        if (oscZoneParameterIds.size() != zoneTargetColors.size() * 3) {
+            oscZoneParameterIds.clear();
+            for (size_t i = 0; i < zoneTargetColors.size(); i++) {
+                std::string prefix = "AL_Zone" + std::to_string(i) + "_";
+                oscZoneParameterIds.push_back(oscManager.RegisterParameter(prefix + "Red"));
+                oscZoneParameterIds.push_back(oscManager.RegisterParameter(prefix + "Green"));
+                oscZoneParameterIds.push_back(oscManager.RegisterParameter(prefix + "Blue"));
+            }
+        }
+
+        int maxId = *std::max_element(oscZoneParameterIds.begin(), oscZoneParameterIds.end());
+        oscValues.resize(maxId + 1, 0.0f);
+        for (size_t i = 0; i < zoneTargetColors.size(); i++) {
+            oscValues[oscZoneParameterIds[i * 3 + 0]] = zoneTargetColors[i].r;
+            oscValues[oscZoneParameterIds[i * 3 + 1]] = zoneTargetColors[i].g;
+            oscValues[oscZoneParameterIds[i * 3 + 2]] = zoneTargetColors[i].b;
+        }
+    }
+
+    oscManager.SendValues(oscValues.data(), oscValues.size());
+}
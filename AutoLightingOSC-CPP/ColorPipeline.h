@@ -0,0 +1,57 @@
+// ColorPipeline.h
+#pragma once
+
+#include <vector>
+#include "ColorProcessor.h"
+#include "IntegralImage.h"
+#include "UserSettings.h"
+
+class OscManager;
+
+// The chain from captured frames to OSC, without any UI, capture backend or timing: frames are
+// averaged into a target colour (and zone colours), the output colour is smoothed towards it and
+// sent. The caller runs each step at its rate. Options are read from the settings on every call.
+class ColorPipeline {
+private:
+    UserSettings& settings;
+    ColorProcessor& colorProcessor;
+    OscManager& oscManager;
+
+    ColorRGB currentColor;
+    ColorRGB targetColor;
+
+    // Per-zone colors when a zone grid is configured
+    std::vector<ColorRGB> zoneAverageColors;
+    std::vector<ColorRGB> zoneTargetColors;
+
+    // Summed-area table of the last frame, only built while zones are laid out inside a crop
+    IntegralImage frameIntegral;
+
+    // The last frame while a selection is being dragged, for UpdateSelectionColor
+    Bitmap selectionFrame;
+
+    // OSC parameter IDs of every zone's R, G and B, and the values sent each OSC tick
+    std::vector<int> oscZoneParameterIds;
+    std::vector<float> oscValues;
+
+public:
+    ColorPipeline(UserSettings& settings, ColorProcessor& colorProcessor, OscManager& oscManager);
+
+    // Averages a captured frame into the target colour. A non-empty crop limits it to that area.
+    // keepFrame holds on to the frame until the next one, for UpdateSelectionColor.
+    void ProcessFrame(const Bitmap& frame, const PixelRect& crop, bool keepFrame = false);
+
+    // Target colour from a region of the last frame kept by ProcessFrame, while a selection is
+    // being dragged. Averaged the same way as a crop, so releasing the selection does not change it.
+    void UpdateSelectionColor(const PixelRect& selection);
+
+    // Moves the output colour towards the target colour, deltaTime seconds after the last step
+    void UpdateSmoothing(float deltaTime);
+
+    // Sends the output colour, followed by the zone colours when a grid is set up
+    void SendOsc();
+
+    const ColorRGB& GetCurrentColor() const { return currentColor; }
+    const ColorRGB& GetTargetColor() const { return targetColor; }
+    const std::vector<ColorRGB>& GetZoneColors() const { return zoneTargetColors; }
+};
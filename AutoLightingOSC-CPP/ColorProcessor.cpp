@@ -21,26 +21,44 @@
 
 // ColorProcessor.cpp
 
-#define NOMINMAX
-#include <windows.h>
-
 #include "ColorProcessor.h"
+#include "PixelKernels.h"
+#include "IntegralImage.h"
 #include <algorithm>
 #include <cmath>
 
+// Bilinear sample of one channel. Shared by DownscaleForProcessing and GetDownscaledAverageColor
+// so that both paths produce bit-identical results.
+static inline uint8_t SampleBilinear(const uint8_t* p11, const uint8_t* p12, const uint8_t* p21, const uint8_t* p22,
+    int c, float dx, float dy) {
+    float top = p11[c] * (1 - dx) + p12[c] * dx;
+    float bottom = p21[c] * (1 - dx) + p22[c] * dx;
+    float value = top * (1 - dy) + bottom * dy;
+
+    return static_cast<uint8_t>(value);
+}
+
+// Sum of the channel at byte offset index, folded away when index is a PixelLayout constant
+static inline uint64_t ChannelSumAt(const ChannelSums& sums, int index) {
+    return index == 0 ? sums.c0 : (index == 1 ? sums.c1 : sums.c2);
+}
+
 ColorProcessor::ColorProcessor(UserSettings& settings)
-    : settings(settings), lastNonBlackColor(), currentSmoothedColor() {
+    : lastNonBlackColor(), currentSmoothedColor(), settings(settings) {
 }
 
-Bitmap ColorProcessor::DownscaleForProcessing(const Bitmap& image) {
+Bitmap ColorProcessor::DownscaleForProcessing(const BitmapView& image) {
     if (!image.IsValid()) {
         return Bitmap();
     }
 
     if (image.width <= MaxProcessingSize && image.height <= MaxProcessingSize) {
-        // Return a copy of the image
-        Bitmap result(image.width, image.height);
-        std::copy(image.data.get(), image.data.get() + (image.stride * image.height), result.data.get());
+        // Return a copy of the image, row by row since the source may be a view into a larger frame
+        Bitmap result(image.width, image.height, image.format);
+        for (int y = 0; y < image.height; y++) {
+            const uint8_t* srcRow = image.data + static_cast<size_t>(y) * image.stride;
+            std::copy(srcRow, srcRow + image.width * 4, result.data.get() + static_cast<size_t>(y) * result.stride);
+        }
         return result;
     }
 
@@ -52,7 +70,7 @@ Bitmap ColorProcessor::DownscaleForProcessing(const Bitmap& image) {
     int newWidth = static_cast<int>(image.width * scale);
     int newHeight = static_cast<int>(image.height * scale);
 
-    Bitmap result(newWidth, newHeight);
+    Bitmap result(newWidth, newHeight, image.format);
 
     // Simple bilinear downscale
     for (int y = 0; y < newHeight; y++) {
@@ -69,18 +87,14 @@ Bitmap ColorProcessor::DownscaleForProcessing(const Bitmap& image) {
             float dy = srcY - srcY1;
 
             // Get source pixels
-            BYTE* p11 = image.data.get() + (srcY1 * image.stride + srcX1 * 4);
-            BYTE* p12 = image.data.get() + (srcY1 * image.stride + srcX2 * 4);
-            BYTE* p21 = image.data.get() + (srcY2 * image.stride + srcX1 * 4);
-            BYTE* p22 = image.data.get() + (srcY2 * image.stride + srcX2 * 4);
+            const uint8_t* p11 = image.data + (srcY1 * image.stride + srcX1 * 4);
+            const uint8_t* p12 = image.data + (srcY1 * image.stride + srcX2 * 4);
+            const uint8_t* p21 = image.data + (srcY2 * image.stride + srcX1 * 4);
+            const uint8_t* p22 = image.data + (srcY2 * image.stride + srcX2 * 4);
 
             // Bilinear interpolation
             for (int c = 0; c < 4; c++) {
-                float top = p11[c] * (1 - dx) + p12[c] * dx;
-                float bottom = p21[c] * (1 - dx) + p22[c] * dx;
-                float value = top * (1 - dy) + bottom * dy;
-
-                result.data.get()[y * result.stride + x * 4 + c] = static_cast<BYTE>(value);
+                result.data.get()[y * result.stride + x * 4 + c] = SampleBilinear(p11, p12, p21, p22, c, dx, dy);
             }
         }
     }
@@ -88,54 +102,257 @@ Bitmap ColorProcessor::DownscaleForProcessing(const Bitmap& image) {
     return result;
 }
 
-ColorRGB ColorProcessor::GetAverageColor(const Bitmap& bitmap) {
+ColorRGB ColorProcessor::GetAverageColor(const BitmapView& bitmap) {
     if (!bitmap.IsValid()) {
         return ColorRGB(0, 0, 0);
     }
 
-    long long r = 0, g = 0, b = 0;
     int totalPixels = bitmap.width * bitmap.height;
 
     if (totalPixels == 0) {
         return ColorRGB(0, 0, 0);
     }
 
-    const BYTE* pixelData = bitmap.data.get();
+    // Vectorised channel sums (4 bytes per pixel, in the bitmap's byte order)
+    ChannelSums sums;
+    SumChannels(bitmap.data, bitmap.width, bitmap.height, bitmap.stride, sums);
+
+    return SumsToColor(sums, totalPixels, bitmap.format);
+}
+
+ColorRGB ColorProcessor::SumsToColor(const ChannelSums& sums, long long pixelCount, PixelFormat format) const {
+    if (pixelCount <= 0) {
+        return ColorRGB(0, 0, 0);
+    }
+
+    return DispatchPixelFormat(format, [&](auto layout) {
+        typedef decltype(layout) Layout;
+        float avgR = static_cast<float>(ChannelSumAt(sums, Layout::Red)) / (pixelCount * 255);
+        float avgG = static_cast<float>(ChannelSumAt(sums, Layout::Green)) / (pixelCount * 255);
+        float avgB = static_cast<float>(ChannelSumAt(sums, Layout::Blue)) / (pixelCount * 255);
+
+        return ColorRGB(avgR, avgG, avgB);
+    });
+}
+
+void ColorProcessor::GetZoneAverageColors(const BitmapView& bitmap, int columns, int rows, std::vector<ColorRGB>& zoneColors) {
+    int zoneColumns = std::clamp(columns, 0, static_cast<int>(MaxZonesPerAxis));
+    int zoneRows = std::clamp(rows, 0, static_cast<int>(MaxZonesPerAxis));
+    zoneColors.assign(static_cast<size_t>(zoneColumns) * zoneRows, ColorRGB(0, 0, 0));
+
+    if (!bitmap.IsValid() || zoneColors.empty()) {
+        return;
+    }
+
+    // Zone boundaries, spread evenly with the remainder distributed across zones
+    int xEdges[MaxZonesPerAxis + 1];
+    int yEdges[MaxZonesPerAxis + 1];
+
+    for (int i = 0; i <= zoneColumns; i++) {
+        xEdges[i] = static_cast<int>(static_cast<long long>(bitmap.width) * i / zoneColumns);
+    }
+    for (int i = 0; i <= zoneRows; i++) {
+        yEdges[i] = static_cast<int>(static_cast<long long>(bitmap.height) * i / zoneRows);
+    }
+
+    ChannelSums sums[MaxZonesPerAxis];
+    const uint8_t* pixelData = bitmap.data;
+
+    // Walk the image row by row, splitting every row between the zones it crosses
+    for (int zy = 0; zy < zoneRows; zy++) {
+        for (int zx = 0; zx < zoneColumns; zx++) {
+            sums[zx] = ChannelSums();
+        }
+
+        for (int y = yEdges[zy]; y < yEdges[zy + 1]; y++) {
+            const uint8_t* row = pixelData + static_cast<size_t>(y) * bitmap.stride;
+
+            for (int zx = 0; zx < zoneColumns; zx++) {
+                SumChannels(row + xEdges[zx] * 4, xEdges[zx + 1] - xEdges[zx], 1, bitmap.stride, sums[zx]);
+            }
+        }
+
+        for (int zx = 0; zx < zoneColumns; zx++) {
+            long long pixelCount = static_cast<long long>(xEdges[zx + 1] - xEdges[zx]) * (yEdges[zy + 1] - yEdges[zy]);
+            zoneColors[static_cast<size_t>(zy) * zoneColumns + zx] = SumsToColor(sums[zx], pixelCount, bitmap.format);
+        }
+    }
+}
+
+void ColorProcessor::GetRegionAverageColors(const BitmapView& bitmap, const std::vector<PixelRect>& regions, std::vector<ColorRGB>& regionColors) {
+    regionColors.assign(regions.size(), ColorRGB(0, 0, 0));
+
+    if (!bitmap.IsValid() || regions.empty()) {
+        return;
+    }
+
+    // Clamp every region to the image and find the rows that any region covers
+    std::vector<PixelRect> clamped(regions.size());
+    std::vector<ChannelSums> sums(regions.size());
+    int firstRow = bitmap.height;
+    int lastRow = 0;
+
+    for (size_t i = 0; i < regions.size(); i++) {
+        PixelRect rect = regions[i];
+        rect.left = std::clamp(rect.left, 0, bitmap.width);
+        rect.right = std::clamp(rect.right, rect.left, bitmap.width);
+        rect.top = std::clamp(rect.top, 0, bitmap.height);
+        rect.bottom = std::clamp(rect.bottom, rect.top, bitmap.height);
+        clamped[i] = rect;
+
+        if (rect.right > rect.left && rect.bottom > rect.top) {
+            firstRow = std::min(firstRow, rect.top);
+            lastRow = std::max(lastRow, rect.bottom);
+        }
+    }
+
+    // Each row is loaded once; overlapping regions re-read it while it is still in cache
+    const uint8_t* pixelData = bitmap.data;
+
+    for (int y = firstRow; y < lastRow; y++) {
+        const uint8_t* row = pixelData + static_cast<size_t>(y) * bitmap.stride;
+
+        for (size_t i = 0; i < clamped.size(); i++) {
+            const PixelRect& rect = clamped[i];
+            if (y >= rect.top && y < rect.bottom && rect.right > rect.left) {
+                SumChannels(row + rect.left * 4, rect.right - rect.left, 1, bitmap.stride, sums[i]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < clamped.size(); i++) {
+        const PixelRect& rect = clamped[i];
+        long long pixelCount = static_cast<long long>(rect.right - rect.left) * (rect.bottom - rect.top);
+        regionColors[i] = SumsToColor(sums[i], pixelCount, bitmap.format);
+    }
+}
+
+ColorRGB ColorProcessor::GetRegionAverageColor(const IntegralImage& integral, const PixelRect& region) {
+    long long pixelCount = 0;
+    ChannelSums sums = integral.GetSums(region, pixelCount);
+    return SumsToColor(sums, pixelCount, integral.GetFormat());
+}
+
+void ColorProcessor::GetZoneAverageColors(const IntegralImage& integral, const PixelRect& area, int columns, int rows, std::vector<ColorRGB>& zoneColors) {
+    int zoneColumns = std::clamp(columns, 0, static_cast<int>(MaxZonesPerAxis));
+    int zoneRows = std::clamp(rows, 0, static_cast<int>(MaxZonesPerAxis));
+    zoneColors.assign(static_cast<size_t>(zoneColumns) * zoneRows, ColorRGB(0, 0, 0));
+
+    if (!integral.IsValid() || zoneColors.empty()) {
+        return;
+    }
+
+    PixelRect bounds = integral.ClampRect(area);
+    int areaWidth = bounds.right - bounds.left;
+    int areaHeight = bounds.bottom - bounds.top;
 
-    for (int y = 0; y < bitmap.height; y++) {
-        for (int x = 0; x < bitmap.width; x++) {
-            int offset = y * bitmap.stride + x * 4; // 4 bytes per pixel (BGRA format)
-            b += pixelData[offset];
-            g += pixelData[offset + 1];
-            r += pixelData[offset + 2];
+    // Same zone boundaries as the single-pass Bitmap version
+    for (int zy = 0; zy < zoneRows; zy++) {
+        for (int zx = 0; zx < zoneColumns; zx++) {
+            PixelRect zone;
+            zone.left = bounds.left + static_cast<int>(static_cast<long long>(areaWidth) * zx / zoneColumns);
+            zone.right = bounds.left + static_cast<int>(static_cast<long long>(areaWidth) * (zx + 1) / zoneColumns);
+            zone.top = bounds.top + static_cast<int>(static_cast<long long>(areaHeight) * zy / zoneRows);
+            zone.bottom = bounds.top + static_cast<int>(static_cast<long long>(areaHeight) * (zy + 1) / zoneRows);
+
+            zoneColors[static_cast<size_t>(zy) * zoneColumns + zx] = GetRegionAverageColor(integral, zone);
         }
     }
+}
+
+ColorRGB ColorProcessor::GetDownscaledAverageColor(const BitmapView& image) {
+    if (!image.IsValid()) {
+        return ColorRGB(0, 0, 0);
+    }
+
+    // Small images are not resampled, so the plain average is already exact
+    if (image.width <= MaxProcessingSize && image.height <= MaxProcessingSize) {
+        return GetAverageColor(image);
+    }
+
+    float scale = std::min(
+        static_cast<float>(MaxProcessingSize) / image.width,
+        static_cast<float>(MaxProcessingSize) / image.height
+    );
+
+    int newWidth = std::min(static_cast<int>(image.width * scale), static_cast<int>(MaxProcessingSize));
+    int newHeight = std::min(static_cast<int>(image.height * scale), static_cast<int>(MaxProcessingSize));
+
+    if (newWidth <= 0 || newHeight <= 0) {
+        return ColorRGB(0, 0, 0);
+    }
+
+    // Horizontal taps are identical for every output row, so compute them once on the stack
+    int tapX1[MaxProcessingSize];
+    int tapX2[MaxProcessingSize];
+    float tapDx[MaxProcessingSize];
+
+    for (int x = 0; x < newWidth; x++) {
+        float srcX = x / scale;
+        tapX1[x] = static_cast<int>(srcX);
+        tapX2[x] = std::min(tapX1[x] + 1, image.width - 1);
+        tapDx[x] = srcX - tapX1[x];
+    }
+
+    // Summed in byte order, the channels are only assigned once at the end
+    ChannelSums sums;
+    const uint8_t* pixelData = image.data;
 
-    float avgR = static_cast<float>(r) / (totalPixels * 255);
-    float avgG = static_cast<float>(g) / (totalPixels * 255);
-    float avgB = static_cast<float>(b) / (totalPixels * 255);
+    // Output rows map to increasing source rows, so the source is walked front to back
+    for (int y = 0; y < newHeight; y++) {
+        float srcY = y / scale;
+        int srcY1 = static_cast<int>(srcY);
+        int srcY2 = std::min(srcY1 + 1, image.height - 1);
+        float dy = srcY - srcY1;
+
+        const uint8_t* row1 = pixelData + srcY1 * image.stride;
+        const uint8_t* row2 = pixelData + srcY2 * image.stride;
 
-    // Swaps Red & Blue channels for Spout2 input
-    if (settings.enableSpout) {
-        std::swap(avgR, avgB);
+        for (int x = 0; x < newWidth; x++) {
+            const uint8_t* p11 = row1 + tapX1[x] * 4;
+            const uint8_t* p12 = row1 + tapX2[x] * 4;
+            const uint8_t* p21 = row2 + tapX1[x] * 4;
+            const uint8_t* p22 = row2 + tapX2[x] * 4;
+            float dx = tapDx[x];
+
+            sums.c0 += SampleBilinear(p11, p12, p21, p22, 0, dx, dy);
+            sums.c1 += SampleBilinear(p11, p12, p21, p22, 1, dx, dy);
+            sums.c2 += SampleBilinear(p11, p12, p21, p22, 2, dx, dy);
+        }
     }
 
-    return ColorRGB(avgR, avgG, avgB);
+    return SumsToColor(sums, static_cast<long long>(newWidth) * newHeight, image.format);
 }
 
 ColorRGB ColorProcessor::ProcessColor(const ColorRGB& avgColor) {
+    return ProcessColor(avgColor, lastNonBlackColor);
+}
+
+void ColorProcessor::ProcessZoneColors(const std::vector<ColorRGB>& avgColors, std::vector<ColorRGB>& zoneColors) {
+    // Zone layout changed, forget the previous per-zone history
+    if (zoneLastNonBlackColors.size() != avgColors.size()) {
+        zoneLastNonBlackColors.assign(avgColors.size(), ColorRGB());
+    }
+
+    zoneColors.resize(avgColors.size());
+    for (size_t i = 0; i < avgColors.size(); i++) {
+        zoneColors[i] = ProcessColor(avgColors[i], zoneLastNonBlackColors[i]);
+    }
+}
+
+ColorRGB ColorProcessor::ProcessColor(const ColorRGB& avgColor, ColorRGB& lastNonBlack) {
     float r = avgColor.r;
     float g = avgColor.g;
     float b = avgColor.b;
 
     // Keep track of last non-black color
     if (r != 0.0f || g != 0.0f || b != 0.0f) {
-        lastNonBlackColor = ColorRGB(r, g, b);
+        lastNonBlack = ColorRGB(r, g, b);
     }
     else {
-        r = lastNonBlackColor.r;
-        g = lastNonBlackColor.g;
-        b = lastNonBlackColor.b;
+        r = lastNonBlack.r;
+        g = lastNonBlack.g;
+        b = lastNonBlack.b;
     }
 
     // Apply max brightness if enabled
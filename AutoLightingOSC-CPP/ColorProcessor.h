@@ -1,25 +1,79 @@
 #pragma once
 
-#include <Windows.h>
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include "UserSettings.h"
+#include "FramePool.h"
+#include "PixelFormat.h"
+
+// Rectangle in image pixel coordinates, right and bottom are exclusive
+struct PixelRect {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+// Non-owning view of 4-byte pixels with an arbitrary row stride.
+// Used for crops so that a region of a frame can be processed without copying it.
+struct BitmapView {
+    const uint8_t* data;
+    int width;
+    int height;
+    int stride;
+    PixelFormat format;
+
+    BitmapView() : data(nullptr), width(0), height(0), stride(0), format(PixelFormat::BGRA8) {}
+    BitmapView(const uint8_t* pixels, int w, int h, int rowStride, PixelFormat pixelFormat = PixelFormat::BGRA8)
+        : data(pixels), width(w), height(h), stride(rowStride), format(pixelFormat) {}
+
+    bool IsValid() const {
+        return data != nullptr && width > 0 && height > 0;
+    }
+
+    // View of rect within this view, clamped to its bounds
+    BitmapView SubView(const PixelRect& rect) const {
+        int left = rect.left < 0 ? 0 : (rect.left > width ? width : rect.left);
+        int top = rect.top < 0 ? 0 : (rect.top > height ? height : rect.top);
+        int right = rect.right < left ? left : (rect.right > width ? width : rect.right);
+        int bottom = rect.bottom < top ? top : (rect.bottom > height ? height : rect.bottom);
+
+        if (!IsValid() || right <= left || bottom <= top) {
+            return BitmapView();
+        }
+        return BitmapView(data + static_cast<size_t>(top) * stride + static_cast<size_t>(left) * 4,
+            right - left, bottom - top, stride, format);
+    }
+};
 
 struct Bitmap {
-    std::shared_ptr<BYTE[]> data;
+    std::shared_ptr<uint8_t[]> data;
     int width;
     int height;
     int stride;
+    PixelFormat format;
 
-    Bitmap() : data(nullptr), width(0), height(0), stride(0) {}
+    Bitmap() : data(nullptr), width(0), height(0), stride(0), format(PixelFormat::BGRA8) {}
 
-    Bitmap(int w, int h) : width(w), height(h), stride(w * 4) {
-        data = std::shared_ptr<BYTE[]>(new BYTE[stride * height]());
+    // Pixels come from the FramePool and are not zero-initialised, every writer fills them
+    Bitmap(int w, int h, PixelFormat pixelFormat = PixelFormat::BGRA8)
+        : width(w), height(h), stride(w * 4), format(pixelFormat) {
+        data = FramePool::Instance().Acquire(static_cast<size_t>(stride) * height);
     }
 
     bool IsValid() const {
         return data != nullptr && width > 0 && height > 0;
     }
+
+    // The view does not keep the pixels alive, the Bitmap must outlive it
+    operator BitmapView() const {
+        return BitmapView(data.get(), width, height, stride, format);
+    }
+
+    BitmapView SubView(const PixelRect& rect) const {
+        return BitmapView(*this).SubView(rect);
+    }
 };
 
 struct ColorRGB {
@@ -37,11 +91,16 @@ struct ColorRGB {
     }
 };
 
+struct ChannelSums;
+class IntegralImage;
+
 class ColorProcessor {
 private:
     static const int MaxProcessingSize = 100; // Maximum width or height for processing
+    static const int MaxZonesPerAxis = 16;    // Maximum zone grid columns or rows
     ColorRGB lastNonBlackColor;
     ColorRGB currentSmoothedColor;
+    std::vector<ColorRGB> zoneLastNonBlackColors;
 
     UserSettings& settings;
 
@@ -52,11 +111,30 @@ private:
     void HSVtoRGB(float h, float s, float v, float& r, float& g, float& b);
     ColorRGB ApplySaturation(float r, float g, float b);
 
+    // sums are in byte order, format says which byte is which channel
+    ColorRGB SumsToColor(const ChannelSums& sums, long long pixelCount, PixelFormat format) const;
+    ColorRGB ProcessColor(const ColorRGB& avgColor, ColorRGB& lastNonBlack);
+
 public:
     ColorProcessor(UserSettings& settings);
 
-    Bitmap DownscaleForProcessing(const Bitmap& image);
-    ColorRGB GetAverageColor(const Bitmap& bitmap);
+    Bitmap DownscaleForProcessing(const BitmapView& image);
+    ColorRGB GetAverageColor(const BitmapView& bitmap);
+
+    // Same result as GetAverageColor(DownscaleForProcessing(image)), computed in a single
+    // pass over the source pixels without allocating the intermediate Bitmap.
+    ColorRGB GetDownscaledAverageColor(const BitmapView& image);
     ColorRGB ProcessColor(const ColorRGB& avgColor);
+
+    // Averages of a columns x rows grid of equal zones (row-major), from one pass over the image
+    void GetZoneAverageColors(const BitmapView& bitmap, int columns, int rows, std::vector<ColorRGB>& zoneColors);
+    // Averages of arbitrary, possibly overlapping, regions from one pass over the image
+    void GetRegionAverageColors(const BitmapView& bitmap, const std::vector<PixelRect>& regions, std::vector<ColorRGB>& regionColors);
+    // Average of a region answered from a prebuilt integral image (four lookups)
+    ColorRGB GetRegionAverageColor(const IntegralImage& integral, const PixelRect& region);
+    // Zone grid over area answered from a prebuilt integral image (four lookups per zone)
+    void GetZoneAverageColors(const IntegralImage& integral, const PixelRect& area, int columns, int rows, std::vector<ColorRGB>& zoneColors);
+    // ProcessColor for every zone, each zone keeping its own last non-black color
+    void ProcessZoneColors(const std::vector<ColorRGB>& avgColors, std::vector<ColorRGB>& zoneColors);
     ColorRGB GetSmoothedColor(float deltaTime, const ColorRGB& targetColor);
 };
\ No newline at end of file
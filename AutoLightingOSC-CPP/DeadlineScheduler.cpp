@@ -0,0 +1,236 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// DeadlineScheduler.cpp
+
+#include "DeadlineScheduler.h"
+#include <algorithm>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif defined(__linux__)
+#include <cerrno>
+#include <time.h>
+#endif
+
+DeadlineScheduler::DeadlineScheduler()
+    : heapRebuilt(false), timerHandle(nullptr) {
+#ifdef _WIN32
+    // High-resolution timers need Windows 10 1803, older versions get a regular one
+    timerHandle = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!timerHandle) {
+        timerHandle = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+#endif
+}
+
+DeadlineScheduler::~DeadlineScheduler() {
+#ifdef _WIN32
+    if (timerHandle) {
+        CloseHandle(timerHandle);
+    }
+#endif
+}
+
+size_t DeadlineScheduler::AddTask(const std::string& name, Clock::duration period, TaskFunction function) {
+    Task task;
+    task.name = name;
+    task.period = period;
+    task.deadline = Clock::now() + period;
+    task.enabled = true;
+    task.function = std::move(function);
+    task.runs = 0;
+    task.skippedDeadlines = 0;
+    task.totalLatenessUs = 0.0;
+    task.maxLatenessUs = 0.0;
+    task.latenessHistogram.assign(LatenessBucketCount + 1, 0);
+    tasks.push_back(std::move(task));
+
+    RebuildHeap();
+    return tasks.size() - 1;
+}
+
+void DeadlineScheduler::SetPeriod(size_t task, Clock::duration period) {
+    if (tasks[task].period == period) {
+        return;
+    }
+
+    tasks[task].period = period;
+    tasks[task].deadline = Clock::now() + period;
+    RebuildHeap();
+}
+
+void DeadlineScheduler::SetEnabled(size_t task, bool enabled) {
+    if (tasks[task].enabled == enabled) {
+        return;
+    }
+
+    tasks[task].enabled = enabled;
+    tasks[task].deadline = Clock::now() + tasks[task].period;
+    RebuildHeap();
+}
+
+void DeadlineScheduler::Reset(Clock::time_point now) {
+    for (Task& task : tasks) {
+        task.deadline = now + task.period;
+    }
+    RebuildHeap();
+}
+
+void DeadlineScheduler::RebuildHeap() {
+    heap.clear();
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (tasks[i].enabled) {
+            heap.push_back({ tasks[i].deadline, i });
+        }
+    }
+
+    std::make_heap(heap.begin(), heap.end(), IsLater);
+    heapRebuilt = true;
+}
+
+bool DeadlineScheduler::RunNext() {
+    if (heap.empty()) {
+        return false;
+    }
+
+    SleepUntil(heap.front().deadline);
+
+    // Everything due by now, including tasks that became due while an earlier one ran.
+    // Each run moves its task's deadline past now, so this always ends.
+    while (!heap.empty() && heap.front().deadline <= Clock::now()) {
+        std::pop_heap(heap.begin(), heap.end(), IsLater);
+        size_t task = heap.back().task;
+        heap.pop_back();
+
+        heapRebuilt = false;
+        RunTask(task);
+
+        // A task that changed the schedule while running rebuilt the heap from the task list
+        if (heapRebuilt) {
+            RebuildHeap();
+        }
+        else if (tasks[task].enabled) {
+            heap.push_back({ tasks[task].deadline, task });
+            std::push_heap(heap.begin(), heap.end(), IsLater);
+        }
+    }
+
+    return true;
+}
+
+void DeadlineScheduler::RunTask(size_t index) {
+    Task& task = tasks[index];
+    Clock::time_point deadline = task.deadline;
+    Clock::time_point now = Clock::now();
+
+    double latenessUs = std::chrono::duration<double, std::micro>(now - deadline).count();
+    int bucket = std::min(static_cast<int>(latenessUs / LatenessBucketUs), LatenessBucketCount);
+    task.latenessHistogram[std::max(bucket, 0)]++;
+    task.totalLatenessUs += latenessUs;
+    task.maxLatenessUs = std::max(task.maxLatenessUs, latenessUs);
+    task.runs++;
+
+    task.function(now);
+
+    // Next deadline from the phase, not from now. If the run (or the wait before it) took
+    // longer than a period, skip to the first deadline still ahead.
+    if (task.deadline == deadline) {
+        task.deadline += task.period;
+
+        Clock::time_point finished = Clock::now();
+        if (task.deadline <= finished && task.period > Clock::duration::zero()) {
+            auto missed = (finished - task.deadline) / task.period + 1;
+            task.deadline += missed * task.period;
+            task.skippedDeadlines += static_cast<uint64_t>(missed);
+        }
+    }
+}
+
+void DeadlineScheduler::SleepUntil(Clock::time_point deadline) {
+    if (deadline <= Clock::now()) {
+        return;
+    }
+
+#ifdef _WIN32
+    if (timerHandle) {
+        // Relative due time in 100 ns units
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now()).count() / 100);
+        if (dueTime.QuadPart < 0 && SetWaitableTimer(timerHandle, &dueTime, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(timerHandle, INFINITE);
+            return;
+        }
+    }
+    std::this_thread::sleep_until(deadline);
+#elif defined(__linux__)
+    // steady_clock is CLOCK_MONOTONIC, so the deadline is used as an absolute time and a
+    // wakeup cut short by a signal resumes without drifting
+    auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    timespec wakeTime;
+    wakeTime.tv_sec = static_cast<time_t>(sinceEpoch / 1000000000);
+    wakeTime.tv_nsec = static_cast<long>(sinceEpoch % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+DeadlineScheduler::TaskStats DeadlineScheduler::GetStats(size_t index) const {
+    const Task& task = tasks[index];
+    TaskStats stats;
+    stats.runs = task.runs;
+    stats.skippedDeadlines = task.skippedDeadlines;
+    stats.maxLatenessUs = task.maxLatenessUs;
+    if (task.runs == 0) {
+        return stats;
+    }
+
+    stats.meanLatenessUs = task.totalLatenessUs / task.runs;
+
+    uint64_t rank = (task.runs * 99 + 99) / 100; // ceil(runs * 0.99)
+    uint64_t count = 0;
+    stats.p99LatenessUs = task.maxLatenessUs;
+    for (int i = 0; i < LatenessBucketCount; i++) {
+        count += task.latenessHistogram[i];
+        if (count >= rank) {
+            stats.p99LatenessUs = std::min(static_cast<double>((i + 1) * LatenessBucketUs), task.maxLatenessUs);
+            break;
+        }
+    }
+    return stats;
+}
+
+void DeadlineScheduler::ResetStats() {
+    for (Task& task : tasks) {
+        task.runs = 0;
+        task.skippedDeadlines = 0;
+        task.totalLatenessUs = 0.0;
+        task.maxLatenessUs = 0.0;
+        std::fill(task.latenessHistogram.begin(), task.latenessHistogram.end(), 0);
+    }
+}
@@ -0,0 +1,88 @@
+// DeadlineScheduler.h
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Runs periodic tasks on the calling thread. The next deadline is kept in a min-heap and the
+// thread sleeps exactly until it with a high-resolution wait (clock_nanosleep on Linux, a
+// high-resolution waitable timer on Windows) instead of polling. Deadlines advance by whole
+// periods from the task's phase rather than from when it ran, so lateness never accumulates
+// into drift. A task that falls more than a period behind skips the missed deadlines instead of
+// running them in a burst. How late every run starts is recorded per task.
+class DeadlineScheduler {
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::function<void(Clock::time_point now)> TaskFunction;
+
+    struct TaskStats {
+        uint64_t runs = 0;
+        uint64_t skippedDeadlines = 0; // Deadlines passed over because the task fell behind
+        double meanLatenessUs = 0.0;   // Time from the deadline to the start of the run
+        double p99LatenessUs = 0.0;    // 10 us resolution up to 10 ms, the maximum above that
+        double maxLatenessUs = 0.0;
+    };
+
+private:
+    static const int LatenessBucketUs = 10;
+    static const int LatenessBucketCount = 1000;
+
+    struct Task {
+        std::string name;
+        Clock::duration period;
+        Clock::time_point deadline;
+        bool enabled;
+        TaskFunction function;
+
+        uint64_t runs;
+        uint64_t skippedDeadlines;
+        double totalLatenessUs;
+        double maxLatenessUs;
+        std::vector<uint32_t> latenessHistogram; // LatenessBucketCount buckets plus one for anything later
+    };
+
+    struct HeapEntry {
+        Clock::time_point deadline;
+        size_t task;
+    };
+
+    std::vector<Task> tasks;
+    std::vector<HeapEntry> heap; // Enabled tasks, earliest deadline first
+    bool heapRebuilt;            // Set by RebuildHeap, so RunNext notices a task changing the schedule
+
+    void* timerHandle; // Waitable timer on Windows, unused elsewhere
+
+    // Heap order, earliest deadline at the front
+    static bool IsLater(const HeapEntry& a, const HeapEntry& b) { return a.deadline > b.deadline; }
+    void RebuildHeap();
+    void RunTask(size_t task);
+    void SleepUntil(Clock::time_point deadline);
+
+public:
+    DeadlineScheduler();
+    ~DeadlineScheduler();
+
+    DeadlineScheduler(const DeadlineScheduler&) = delete;
+    DeadlineScheduler& operator=(const DeadlineScheduler&) = delete;
+
+    // Returns the task's ID. It first runs one period after the next Reset. Periods must be positive.
+    size_t AddTask(const std::string& name, Clock::duration period, TaskFunction function);
+    // Changing the period restarts the task's phase from now, setting the same one does nothing
+    void SetPeriod(size_t task, Clock::duration period);
+    // A task that is enabled again first runs one period later
+    void SetEnabled(size_t task, bool enabled);
+    // Every enabled task next runs one period after now
+    void Reset(Clock::time_point now);
+
+    // Sleeps until the earliest deadline, then runs every task that is due, in deadline order.
+    // Returns false straight away if no task is enabled.
+    bool RunNext();
+
+    size_t GetTaskCount() const { return tasks.size(); }
+    const std::string& GetTaskName(size_t task) const { return tasks[task].name; }
+    TaskStats GetStats(size_t task) const;
+    void ResetStats();
+};
@@ -0,0 +1,178 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// FramePool.cpp
+
+#include "FramePool.h"
+#include <new>
+
+// Recycles the fixed-size shared_ptr control blocks, one free list per block type
+template <typename T>
+class ControlBlockAllocator {
+public:
+    typedef T value_type;
+
+    ControlBlockAllocator() = default;
+    template <typename U>
+    ControlBlockAllocator(const ControlBlockAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n == 1) {
+            FreeList& list = GetFreeList();
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (!list.blocks.empty()) {
+                void* block = list.blocks.back();
+                list.blocks.pop_back();
+                return static_cast<T*>(block);
+            }
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* block, size_t n) {
+        if (n == 1) {
+            FreeList& list = GetFreeList();
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (list.blocks.size() < MaxFreeBlocks) {
+                list.blocks.push_back(block);
+                return;
+            }
+        }
+        ::operator delete(block);
+    }
+
+    template <typename U>
+    bool operator==(const ControlBlockAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const ControlBlockAllocator<U>&) const { return false; }
+
+private:
+    static const size_t MaxFreeBlocks = 64;
+
+    struct FreeList {
+        std::mutex mutex;
+        std::vector<void*> blocks;
+
+        FreeList() { blocks.reserve(MaxFreeBlocks); }
+    };
+
+    // Intentionally leaked so frames released during static destruction stay safe
+    static FreeList& GetFreeList() {
+        static FreeList* list = new FreeList();
+        return *list;
+    }
+};
+
+FramePool& FramePool::Instance() {
+    // Intentionally leaked so frames released during static destruction stay safe
+    static FramePool* pool = new FramePool();
+    return *pool;
+}
+
+size_t FramePool::GetBucketSize(size_t size) {
+    // Round up to 1/8th of the next power of two so that small changes in capture size
+    // (window resizes) keep landing in the same bucket, wasting at most 12.5%
+    size_t granularity = Alignment;
+    while (granularity * 8 < size) {
+        granularity *= 2;
+    }
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+FramePool::Bucket& FramePool::GetBucket(size_t bucketSize) {
+    for (Bucket& bucket : buckets) {
+        if (bucket.size == bucketSize) {
+            return bucket;
+        }
+    }
+
+    buckets.push_back(Bucket());
+    buckets.back().size = bucketSize;
+    buckets.back().buffers.reserve(MaxBuffersPerBucket);
+    return buckets.back();
+}
+
+std::shared_ptr<uint8_t[]> FramePool::Acquire(size_t size) {
+    size_t bucketSize = GetBucketSize(size == 0 ? 1 : size);
+    uint8_t* buffer = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Bucket& bucket = GetBucket(bucketSize);
+        if (!bucket.buffers.empty()) {
+            buffer = bucket.buffers.back();
+            bucket.buffers.pop_back();
+            stats.cachedBuffers--;
+            stats.cachedBytes -= bucketSize;
+            stats.reuses++;
+        }
+        else {
+            stats.heapAllocations++;
+        }
+    }
+
+    if (!buffer) {
+        buffer = static_cast<uint8_t*>(::operator new(bucketSize, std::align_val_t(Alignment)));
+    }
+
+    return std::shared_ptr<uint8_t[]>(buffer, Deleter{ bucketSize }, ControlBlockAllocator<uint8_t>());
+}
+
+void FramePool::Deleter::operator()(uint8_t* buffer) const {
+    FramePool::Instance().Release(buffer, bucketSize);
+}
+
+void FramePool::Release(uint8_t* buffer, size_t bucketSize) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Bucket& bucket = GetBucket(bucketSize);
+        if (bucket.buffers.size() < MaxBuffersPerBucket && stats.cachedBytes + bucketSize <= MaxCachedBytes) {
+            bucket.buffers.push_back(buffer);
+            stats.cachedBuffers++;
+            stats.cachedBytes += bucketSize;
+            return;
+        }
+    }
+
+    ::operator delete(buffer, std::align_val_t(Alignment));
+}
+
+void FramePool::Trim() {
+    std::vector<Bucket> released;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released.swap(buckets);
+        stats.cachedBuffers = 0;
+        stats.cachedBytes = 0;
+    }
+
+    for (Bucket& bucket : released) {
+        for (uint8_t* buffer : bucket.buffers) {
+            ::operator delete(buffer, std::align_val_t(Alignment));
+        }
+    }
+}
+
+FramePool::Stats FramePool::GetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
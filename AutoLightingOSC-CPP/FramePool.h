@@ -0,0 +1,58 @@
+// FramePool.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Size-bucketed, thread-safe pool of pixel buffers.
+// Buffers are 64-byte aligned for SIMD, are not zero-initialised, and return to the pool
+// when the last shared_ptr owning them is released. Shared-ownership control blocks are
+// recycled as well, so a steady stream of same-sized frames makes no heap allocations.
+class FramePool {
+public:
+    static const size_t Alignment = 64;
+
+    struct Stats {
+        uint64_t heapAllocations = 0; // Buffers that had to come from the heap
+        uint64_t reuses = 0;          // Buffers handed out from the pool
+        size_t cachedBuffers = 0;
+        size_t cachedBytes = 0;
+    };
+
+    static FramePool& Instance();
+
+    // Uninitialised buffer of at least size bytes
+    std::shared_ptr<uint8_t[]> Acquire(size_t size);
+
+    // Frees every cached buffer
+    void Trim();
+
+    Stats GetStats();
+
+private:
+    static const size_t MaxBuffersPerBucket = 4;
+    static const size_t MaxCachedBytes = 512ull * 1024 * 1024;
+
+    struct Bucket {
+        size_t size;
+        std::vector<uint8_t*> buffers;
+    };
+
+    struct Deleter {
+        size_t bucketSize;
+        void operator()(uint8_t* buffer) const;
+    };
+
+    std::mutex mutex;
+    std::vector<Bucket> buckets;
+    Stats stats;
+
+    FramePool() = default;
+
+    static size_t GetBucketSize(size_t size);
+    Bucket& GetBucket(size_t bucketSize);
+    void Release(uint8_t* buffer, size_t bucketSize);
+};
@@ -0,0 +1,281 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// FrameRecording.cpp
+
+#include "FrameRecording.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+constexpr char RecordingFileHeader::Magic[8];
+constexpr uint32_t RecordingFileHeader::CurrentVersion;
+constexpr size_t RecordingFileHeader::Alignment;
+constexpr uint32_t RecordingFrameHeader::Magic;
+
+static size_t AlignUp(size_t value) {
+    return (value + RecordingFileHeader::Alignment - 1) & ~(RecordingFileHeader::Alignment - 1);
+}
+
+FrameRecorder::FrameRecorder() : used(0), frameCount(0) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    Close();
+}
+
+bool FrameRecorder::Open(const std::string& path) {
+    Close();
+
+    if (!file.OpenWrite(path, InitialCapacity)) {
+        return false;
+    }
+
+    RecordingFileHeader header = {};
+    std::memcpy(header.magic, RecordingFileHeader::Magic, sizeof(header.magic));
+    header.version = RecordingFileHeader::CurrentVersion;
+    header.headerSize = sizeof(RecordingFileHeader);
+    std::memcpy(file.GetData(), &header, sizeof(header));
+
+    used = AlignUp(sizeof(RecordingFileHeader));
+    frameCount = 0;
+    frameOffsets.clear();
+    return true;
+}
+
+bool FrameRecorder::Reserve(size_t bytes) {
+    if (used + bytes <= file.GetSize()) {
+        return true;
+    }
+
+    // Doubling keeps the number of remaps logarithmic in the length of the recording
+    size_t capacity = std::max(file.GetSize() * 2, used + bytes);
+    return file.Resize(capacity);
+}
+
+bool FrameRecorder::Append(const BitmapView& frame, std::chrono::steady_clock::time_point timestamp, const PixelRect& crop) {
+    if (!file.IsOpen() || !frame.IsValid()) {
+        return false;
+    }
+
+    size_t rowBytes = static_cast<size_t>(frame.width) * 4;
+    size_t pixelBytes = rowBytes * frame.height;
+    size_t recordBytes = AlignUp(sizeof(RecordingFrameHeader) + pixelBytes);
+    if (!Reserve(recordBytes)) {
+        Close();
+        return false;
+    }
+
+    if (frameCount == 0) {
+        firstTimestamp = timestamp;
+    }
+
+    RecordingFrameHeader header = {};
+    header.magic = RecordingFrameHeader::Magic;
+    header.format = static_cast<uint32_t>(frame.format);
+    header.width = frame.width;
+    header.height = frame.height;
+    header.cropLeft = crop.left;
+    header.cropTop = crop.top;
+    header.cropRight = crop.right;
+    header.cropBottom = crop.bottom;
+    header.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(timestamp - firstTimestamp).count();
+    header.pixelBytes = pixelBytes;
+
+    uint8_t* record = file.GetData() + used;
+    std::memcpy(record, &header, sizeof(header));
+
+    // Rows are stored packed, whatever the capture's stride was
+    uint8_t* pixels = record + sizeof(RecordingFrameHeader);
+    for (int y = 0; y < frame.height; y++) {
+        std::memcpy(pixels + rowBytes * y, frame.data + static_cast<size_t>(frame.stride) * y, rowBytes);
+    }
+
+    frameOffsets.push_back(used);
+    used += recordBytes;
+    frameCount++;
+
+    // Readable up to here even if the recorder never gets to Close
+    reinterpret_cast<RecordingFileHeader*>(file.GetData())->frameCount = frameCount;
+    return true;
+}
+
+void FrameRecorder::Close() {
+    if (file.IsOpen()) {
+        size_t indexBytes = frameOffsets.size() * sizeof(uint64_t);
+        if (Reserve(indexBytes)) {
+            if (indexBytes > 0) {
+                std::memcpy(file.GetData() + used, frameOffsets.data(), indexBytes);
+            }
+
+            RecordingFileHeader* header = reinterpret_cast<RecordingFileHeader*>(file.GetData());
+            header->frameCount = frameCount;
+            header->indexOffset = used;
+            used += indexBytes;
+        }
+
+        file.Resize(used);
+    }
+
+    // Closed even when a failed remap left nothing mapped
+    file.Close();
+    frameOffsets.clear();
+}
+
+bool FrameRecordingReader::Open(const std::string& path, std::string& error) {
+    Close();
+
+    std::shared_ptr<MappedFile> mapped = std::make_shared<MappedFile>();
+    if (!mapped->OpenRead(path)) {
+        error = "Could not open recording \"" + path + "\"";
+        return false;
+    }
+
+    RecordingFileHeader header;
+    if (mapped->GetSize() < sizeof(header)) {
+        error = "\"" + path + "\" is not a frame recording";
+        return false;
+    }
+    std::memcpy(&header, mapped->GetData(), sizeof(header));
+    if (std::memcmp(header.magic, RecordingFileHeader::Magic, sizeof(header.magic)) != 0) {
+        error = "\"" + path + "\" is not a frame recording";
+        return false;
+    }
+    if (header.version != RecordingFileHeader::CurrentVersion) {
+        error = "\"" + path + "\" is a recording of an unsupported version";
+        return false;
+    }
+
+    file = mapped;
+    if (!ReadIndex(header)) {
+        ScanFrames();
+    }
+    return true;
+}
+
+// A complete frame at offset that ends by end: every field the reader uses is in range and the
+// pixels fit, so nothing handed out can point outside the mapping
+bool FrameRecordingReader::IsValidFrame(size_t offset, size_t end) const {
+    if (offset % RecordingFileHeader::Alignment != 0 || end > file->GetSize() ||
+        offset > end || sizeof(RecordingFrameHeader) > end - offset) {
+        return false;
+    }
+
+    const RecordingFrameHeader* header = reinterpret_cast<const RecordingFrameHeader*>(file->GetData() + offset);
+    if (header->magic != RecordingFrameHeader::Magic ||
+        (header->format != static_cast<uint32_t>(PixelFormat::BGRA8) && header->format != static_cast<uint32_t>(PixelFormat::RGBA8)) ||
+        header->width <= 0 || header->height <= 0 || header->width > INT_MAX / 4) {
+        return false;
+    }
+
+    // Divided rather than multiplied, so a corrupt size cannot overflow into a match
+    uint64_t rowBytes = static_cast<uint64_t>(header->width) * 4;
+    return header->pixelBytes % rowBytes == 0 && header->pixelBytes / rowBytes == static_cast<uint64_t>(header->height) &&
+        header->pixelBytes <= end - offset - sizeof(RecordingFrameHeader);
+}
+
+bool FrameRecordingReader::ReadIndex(const RecordingFileHeader& header) {
+    size_t fileSize = file->GetSize();
+    if (header.indexOffset == 0 || header.indexOffset > fileSize ||
+        header.frameCount > (fileSize - header.indexOffset) / sizeof(uint64_t)) {
+        return false;
+    }
+
+    frameOffsets.resize(static_cast<size_t>(header.frameCount));
+    if (!frameOffsets.empty()) {
+        std::memcpy(frameOffsets.data(), file->GetData() + header.indexOffset, frameOffsets.size() * sizeof(uint64_t));
+    }
+
+    // Only trust an index that points at complete frames before it
+    for (uint64_t offset : frameOffsets) {
+        if (offset > header.indexOffset || !IsValidFrame(static_cast<size_t>(offset), static_cast<size_t>(header.indexOffset))) {
+            frameOffsets.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void FrameRecordingReader::ScanFrames() {
+    frameOffsets.clear();
+    size_t fileSize = file->GetSize();
+    size_t offset = AlignUp(sizeof(RecordingFileHeader));
+
+    // Up to the first block that is not a complete frame, the rest is unused capacity or an index
+    while (IsValidFrame(offset, fileSize)) {
+        const RecordingFrameHeader* header = reinterpret_cast<const RecordingFrameHeader*>(file->GetData() + offset);
+        frameOffsets.push_back(offset);
+        offset += AlignUp(sizeof(RecordingFrameHeader) + static_cast<size_t>(header->pixelBytes));
+    }
+}
+
+void FrameRecordingReader::Close() {
+    file.reset();
+    frameOffsets.clear();
+}
+
+const RecordingFrameHeader& FrameRecordingReader::GetHeader(size_t index) const {
+    return *reinterpret_cast<const RecordingFrameHeader*>(file->GetData() + frameOffsets[index]);
+}
+
+int64_t FrameRecordingReader::GetDurationUs() const {
+    return frameOffsets.empty() ? 0 : GetHeader(frameOffsets.size() - 1).timestampUs;
+}
+
+RecordedFrame FrameRecordingReader::GetFrame(size_t index) const {
+    const RecordingFrameHeader& header = GetHeader(index);
+
+    RecordedFrame frame;
+    frame.view = BitmapView(file->GetData() + frameOffsets[index] + sizeof(RecordingFrameHeader),
+        header.width, header.height, header.width * 4, static_cast<PixelFormat>(header.format));
+    frame.timestampUs = header.timestampUs;
+    frame.crop = { header.cropLeft, header.cropTop, header.cropRight, header.cropBottom };
+    return frame;
+}
+
+Bitmap FrameRecordingReader::GetBitmap(size_t index) const {
+    const RecordingFrameHeader& header = GetHeader(index);
+
+    Bitmap bitmap;
+    bitmap.data = std::shared_ptr<uint8_t[]>(file, file->GetData() + frameOffsets[index] + sizeof(RecordingFrameHeader));
+    bitmap.width = header.width;
+    bitmap.height = header.height;
+    bitmap.stride = header.width * 4;
+    bitmap.format = static_cast<PixelFormat>(header.format);
+    return bitmap;
+}
+
+size_t FrameRecordingReader::FindFrame(int64_t timestampUs) const {
+    // First frame after timestampUs, then one back
+    size_t low = 0;
+    size_t high = frameOffsets.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (GetHeader(middle).timestampUs <= timestampUs) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return low > 0 ? low - 1 : 0;
+}
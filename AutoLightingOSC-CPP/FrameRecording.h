@@ -0,0 +1,115 @@
+// FrameRecording.h
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ColorProcessor.h" // For Bitmap struct
+#include "MappedFile.h"
+
+// Captured frames in one memory-mapped file, to replay a user's screen later.
+//
+// Layout (native byte order, little-endian on every supported platform), every block 64-byte
+// aligned so the pixels are too:
+//   RecordingFileHeader
+//   per frame: RecordingFrameHeader, then height rows of width * 4 bytes
+//   index: the offset of every frame header, written when the recording is closed
+// A recording that was never closed (the recorder crashed) has no index and is read by walking
+// the frames from the start.
+struct RecordingFileHeader {
+    static constexpr char Magic[8] = { 'A', 'L', 'F', 'R', 'A', 'M', 'E', 'S' };
+    static constexpr uint32_t CurrentVersion = 1;
+    static constexpr size_t Alignment = 64; // Of every header, and so of the pixels
+
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;  // sizeof(RecordingFileHeader)
+    uint64_t frameCount;  // Kept current while recording
+    uint64_t indexOffset; // 0 until the recording is closed
+    uint8_t reserved[32];
+};
+
+struct RecordingFrameHeader {
+    static constexpr uint32_t Magic = 0x454D5246; // "FRME"
+
+    uint32_t magic;
+    uint32_t format;      // PixelFormat
+    int32_t width;
+    int32_t height;
+    int32_t cropLeft;     // Area that was averaged, empty for the whole frame
+    int32_t cropTop;
+    int32_t cropRight;
+    int32_t cropBottom;
+    int64_t timestampUs;  // Since the first frame
+    uint64_t pixelBytes;  // width * 4 * height
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(RecordingFileHeader) == RecordingFileHeader::Alignment, "The file header fills one block");
+static_assert(sizeof(RecordingFrameHeader) == RecordingFileHeader::Alignment, "Frame headers fill one block");
+
+// Appends frames to a recording. Not thread-safe, the capturing thread owns it.
+class FrameRecorder {
+private:
+    static const size_t InitialCapacity = 64 * 1024 * 1024;
+
+    MappedFile file;
+    size_t used;
+    uint64_t frameCount;
+    std::vector<uint64_t> frameOffsets;
+    std::chrono::steady_clock::time_point firstTimestamp;
+
+    bool Reserve(size_t bytes);
+
+public:
+    FrameRecorder();
+    ~FrameRecorder();
+
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    // Creates the recording, replacing an existing file
+    bool Open(const std::string& path);
+    // False when the file could not grow, the recording is then closed with what it has
+    bool Append(const BitmapView& frame, std::chrono::steady_clock::time_point timestamp, const PixelRect& crop);
+    // Writes the index and trims the file to its contents
+    void Close();
+
+    bool IsOpen() const { return file.IsOpen(); }
+    uint64_t GetFrameCount() const { return frameCount; }
+};
+
+struct RecordedFrame {
+    BitmapView view;
+    int64_t timestampUs = 0; // Since the first frame
+    PixelRect crop = { 0, 0, 0, 0 };
+};
+
+// Random access to the frames of a recording, straight from the mapping
+class FrameRecordingReader {
+private:
+    std::shared_ptr<MappedFile> file;
+    std::vector<uint64_t> frameOffsets;
+
+    bool IsValidFrame(size_t offset, size_t end) const;
+    bool ReadIndex(const RecordingFileHeader& header);
+    void ScanFrames();
+    const RecordingFrameHeader& GetHeader(size_t index) const;
+
+public:
+    // False with a message when the file is missing or not a recording
+    bool Open(const std::string& path, std::string& error);
+    // Frames handed out by GetBitmap keep the mapping alive until they are released
+    void Close();
+
+    size_t GetFrameCount() const { return frameOffsets.size(); }
+    int64_t GetDurationUs() const;
+
+    RecordedFrame GetFrame(size_t index) const;
+    // The frame's pixels as a Bitmap sharing the (copy-on-write) mapping, nothing is copied
+    Bitmap GetBitmap(size_t index) const;
+    // Last frame recorded at or before timestampUs
+    size_t FindFrame(int64_t timestampUs) const;
+};
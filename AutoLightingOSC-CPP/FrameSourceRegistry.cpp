@@ -0,0 +1,67 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// FrameSourceRegistry.cpp
+
+#include "FrameSourceRegistry.h"
+
+const FrameSourceRegistry::Entry* FrameSourceRegistry::Find(const std::string& name) const {
+    for (const Entry& entry : entries) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void FrameSourceRegistry::Register(const std::string& name, const std::string& description, Factory factory) {
+    for (Entry& entry : entries) {
+        if (entry.name == name) {
+            entry.description = description;
+            entry.factory = std::move(factory);
+            return;
+        }
+    }
+    entries.push_back({ name, description, std::move(factory) });
+}
+
+std::unique_ptr<IFrameSource> FrameSourceRegistry::Create(const std::string& name) const {
+    const Entry* entry = Find(name);
+    if (!entry || !entry->factory) {
+        return nullptr;
+    }
+    return entry->factory();
+}
+
+std::vector<std::string> FrameSourceRegistry::GetNames() const {
+    std::vector<std::string> names;
+    names.reserve(entries.size());
+    for (const Entry& entry : entries) {
+        names.push_back(entry.name);
+    }
+    return names;
+}
+
+std::string FrameSourceRegistry::GetDescription(const std::string& name) const {
+    const Entry* entry = Find(name);
+    return entry ? entry->description : std::string();
+}
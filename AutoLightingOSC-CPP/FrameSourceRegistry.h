@@ -0,0 +1,37 @@
+// FrameSourceRegistry.h
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IFrameSource.h"
+
+// Frame source backends by name. Registering only stores how to create a backend, nothing is
+// constructed before Create, so backends that are never selected cost nothing.
+class FrameSourceRegistry {
+public:
+    typedef std::function<std::unique_ptr<IFrameSource>()> Factory;
+
+private:
+    struct Entry {
+        std::string name;
+        std::string description;
+        Factory factory;
+    };
+
+    std::vector<Entry> entries; // In registration order
+
+    const Entry* Find(const std::string& name) const;
+
+public:
+    // Replaces a backend registered under the same name
+    void Register(const std::string& name, const std::string& description, Factory factory);
+
+    bool Contains(const std::string& name) const { return Find(name) != nullptr; }
+    // A new instance of the backend, null when none has that name
+    std::unique_ptr<IFrameSource> Create(const std::string& name) const;
+
+    std::vector<std::string> GetNames() const;
+    std::string GetDescription(const std::string& name) const;
+};
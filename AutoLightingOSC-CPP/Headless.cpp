@@ -0,0 +1,520 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// Headless.cpp
+//
+// AutoLightOSC without a window, for always-on machines and scripts: no ImGui context, swap chain
+// or render loop, only a frame source, the PipelineThread and OscManager. Settings come from the
+// saved settings file and can be overridden with flags, and a stats line is printed periodically.
+// Sources come from a FrameSourceRegistry: on Windows the DXGI, Windows Graphics Capture and Spout
+// backends, on a D3D11 device of their own; everywhere, a test pattern that runs the whole
+// pipeline without any capture backend, and the replay of a recording made with --record.
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <d3d11.h>
+#include <d3d11_4.h>
+#endif
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include "ColorProcessor.h"
+#include "OscManager.h"
+#include "PipelineThread.h"
+#include "UserSettings.h"
+#include "FrameRecording.h"
+#include "FrameSourceRegistry.h"
+#include "ReplayFrameSource.h"
+#include "TestPatternSource.h"
+#ifdef _WIN32
+#include "WindowManager.h"
+#include "WindowsFrameSources.h"
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void OnStopSignal(int) {
+    stopRequested = 1;
+}
+
+struct HeadlessOptions {
+    std::string source;          // Name in the registry, empty for the backend the settings use
+    std::string window;          // Part of the target window's title or process name, empty for VRChat
+    bool useSavedSettings = true;
+    bool saveSettings = false;
+    double statsInterval = 5.0;  // Seconds between stats lines, 0 for none
+    double duration = 0.0;       // Seconds to run, 0 until interrupted
+    double patternPeriod = 10.0; // Seconds for the test pattern to cycle through every hue
+    std::string record;          // Recording to write every captured frame to, empty for none
+    std::string replay;          // Recording the replay source plays
+    double replaySpeed = 1.0;    // 0 for every frame in order, as fast as the capture rate allows
+    bool replayLoop = false;
+};
+
+#ifdef _WIN32
+// What the Windows backends need without the GUI: a D3D11 device nothing is ever presented on,
+// and a target window found by name and looked up again when it closes
+class HeadlessCaptureContext {
+private:
+    WindowManager windowManager;
+    std::string windowFilter;
+    bool keepWindowOnTop;
+    HWND window = nullptr;
+    Clock::time_point lastWindowSearch;
+
+    ID3D11Device* device = nullptr;
+    ID3D11DeviceContext* deviceContext = nullptr;
+    WindowsCaptureContext context;
+
+    static std::string ToLower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) {
+            return static_cast<char>(std::tolower(c));
+        });
+        return text;
+    }
+
+    HWND FindTargetWindow() {
+        if (windowFilter.empty()) {
+            return windowManager.FindVRChatWindow();
+        }
+
+        std::string filter = ToLower(windowFilter);
+        for (const WindowInfo& info : windowManager.GetOpenWindows()) {
+            if (ToLower(info.title).find(filter) != std::string::npos ||
+                ToLower(info.processName).find(filter) != std::string::npos) {
+                return info.handle;
+            }
+        }
+        return nullptr;
+    }
+
+    // Follows the target across restarts, looking for it again at most once a second
+    HWND GetWindow() {
+        if (!windowManager.IsWindowValid(window)) {
+            Clock::time_point now = Clock::now();
+            if (now - lastWindowSearch < std::chrono::seconds(1)) {
+                return nullptr;
+            }
+            lastWindowSearch = now;
+
+            window = FindTargetWindow();
+            if (window && keepWindowOnTop) {
+                windowManager.SetWindowOnTop(window);
+            }
+        }
+        return window;
+    }
+
+public:
+    HeadlessCaptureContext(const std::string& windowFilter, bool keepWindowOnTop)
+        : windowFilter(windowFilter), keepWindowOnTop(keepWindowOnTop) {
+        context.windowManager = &windowManager;
+        context.getWindow = [this]() { return GetWindow(); };
+    }
+
+    ~HeadlessCaptureContext() {
+        if (keepWindowOnTop && window) {
+            windowManager.SetWindowNotTopMost(window);
+        }
+        if (deviceContext) {
+            deviceContext->Release();
+        }
+        if (device) {
+            device->Release();
+        }
+    }
+
+    HeadlessCaptureContext(const HeadlessCaptureContext&) = delete;
+    HeadlessCaptureContext& operator=(const HeadlessCaptureContext&) = delete;
+
+    bool CreateDevice(std::string& error) {
+        const D3D_FEATURE_LEVEL featureLevels[2] = { D3D_FEATURE_LEVEL_11_0, D3D_FEATURE_LEVEL_10_0 };
+        if (FAILED(D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, D3D11_CREATE_DEVICE_BGRA_SUPPORT,
+            featureLevels, 2, D3D11_SDK_VERSION, &device, nullptr, &deviceContext))) {
+            error = "Could not create a D3D11 device";
+            return false;
+        }
+
+        // Created here, used from the pipeline thread
+        ID3D11Multithread* multithread = nullptr;
+        if (SUCCEEDED(deviceContext->QueryInterface(__uuidof(ID3D11Multithread), reinterpret_cast<void**>(&multithread)))) {
+            multithread->SetMultithreadProtected(TRUE);
+            multithread->Release();
+        }
+
+        context.device = device;
+        context.deviceContext = deviceContext;
+        return true;
+    }
+
+    const WindowsCaptureContext& GetContext() const { return context; }
+};
+#endif
+
+static void PrintUsage(const char* program, const FrameSourceRegistry& frameSources) {
+    std::fprintf(stderr,
+        "Usage: %s [options]\n"
+        "\n"
+        "Runs capture, colour processing and OSC output without a window until interrupted.\n"
+        "Options default to the saved settings.\n"
+        "\n"
+        "  --source NAME                    Frame source, one of the list below\n"
+#ifdef _WIN32
+        "                                   (default: the capture backend of the settings)\n"
+        "  --window TEXT                    Capture the first window whose title or process contains TEXT\n"
+        "                                   (default: VRChat)\n"
+#endif
+        "  --pattern-period SECONDS         Time the test pattern takes to cycle through every hue (10)\n"
+        "  --record FILE                    Record every captured frame, with its crop and timestamp, to FILE\n"
+        "  --replay FILE                    Recording to play back (implies --source replay)\n"
+        "  --replay-speed N|max             Replay N times real time, or max for every frame in order,\n"
+        "                                   back to back regardless of --capture-fps (1)\n"
+        "  --replay-loop                    Start the replay over at the end instead of exiting\n"
+        "  --capture-fps N                  Capture rate, 1 to 60\n"
+        "  --osc-rate N                     OSC updates per second, 1 to 240\n"
+        "  --osc-port N                     OSC port on 127.0.0.1\n"
+        "  --smoothing off|SECONDS          Disable smoothing or set the smoothing rate\n"
+        "  --white-mix N                    0 to 100\n"
+        "  --saturation N                   -100 to 100\n"
+        "  --max-brightness on|off\n"
+        "  --bundles on|off                 Send each update as one OSC bundle\n"
+        "  --async on|off                   Send OSC from a background thread\n"
+        "  --zones COLUMNSxROWS             Lighting zone grid, 1x1 for none\n"
+        "  --defaults                       Start from the default settings instead of the saved ones\n"
+        "  --save                           Save the resulting settings\n"
+        "  --stats-interval SECONDS         Time between stats lines, 0 for none (5)\n"
+        "  --duration SECONDS               Exit after this long, 0 to run until interrupted (0)\n"
+        "\n"
+        "Sources:\n",
+        program);
+
+    for (const std::string& name : frameSources.GetNames()) {
+        std::fprintf(stderr, "  %-32s %s\n", name.c_str(), frameSources.GetDescription(name).c_str());
+    }
+}
+
+static bool ParseSwitch(const std::string& value, bool& result) {
+    if (value == "on") {
+        result = true;
+        return true;
+    }
+    if (value == "off") {
+        result = false;
+        return true;
+    }
+    return false;
+}
+
+// Applies the flags on top of settings, false on anything it does not understand
+static bool ParseArguments(int argc, char** argv, UserSettings& settings, HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--defaults") {
+            continue; // Handled before the settings were loaded
+        }
+        if (arg == "--save") {
+            options.saveSettings = true;
+            continue;
+        }
+        if (arg == "--replay-loop") {
+            options.replayLoop = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+
+        std::string value = argv[++i];
+        if (arg == "--source") options.source = value;
+        else if (arg == "--window") options.window = value;
+        else if (arg == "--pattern-period") options.patternPeriod = std::atof(value.c_str());
+        else if (arg == "--record") options.record = value;
+        else if (arg == "--replay") options.replay = value;
+        else if (arg == "--replay-speed") options.replaySpeed = value == "max" ? 0.0 : std::max(0.01, std::atof(value.c_str()));
+        else if (arg == "--capture-fps") settings.captureFps = std::clamp(std::atoi(value.c_str()), 1, 60);
+        else if (arg == "--osc-rate") settings.oscRate = std::clamp(std::atoi(value.c_str()), 1, 240);
+        else if (arg == "--osc-port") settings.oscPort = std::clamp(std::atoi(value.c_str()), 1, 65535);
+        else if (arg == "--white-mix") settings.whiteMixValue = std::clamp(std::atoi(value.c_str()), 0, 100);
+        else if (arg == "--saturation") settings.saturationValue = std::clamp(std::atoi(value.c_str()), -100, 100);
+        else if (arg == "--max-brightness") { if (!ParseSwitch(value, settings.forceMaxBrightness)) return false; }
+        else if (arg == "--bundles") { if (!ParseSwitch(value, settings.oscUseBundles)) return false; }
+        else if (arg == "--async") { if (!ParseSwitch(value, settings.oscAsync)) return false; }
+        else if (arg == "--smoothing") {
+            settings.enableSmoothing = value != "off";
+            if (settings.enableSmoothing) {
+                settings.smoothingRateValue = static_cast<float>(std::max(0.01, std::atof(value.c_str())));
+            }
+        }
+        else if (arg == "--zones") {
+            int columns = 0;
+            int rows = 0;
+            if (std::sscanf(value.c_str(), "%dx%d", &columns, &rows) != 2) {
+                return false;
+            }
+            settings.zoneColumns = std::clamp(columns, 1, 16);
+            settings.zoneRows = std::clamp(rows, 1, 16);
+        }
+        else if (arg == "--stats-interval") options.statsInterval = std::max(0.0, std::atof(value.c_str()));
+        else if (arg == "--duration") options.duration = std::max(0.0, std::atof(value.c_str()));
+        else return false;
+    }
+    return true;
+}
+
+static void PrintStats(double elapsedSeconds, double fps, const PipelineThread::Output& output,
+    OscManager& oscManager, const UserSettings& settings) {
+    OscManager::Stats oscStats = oscManager.GetStats();
+    std::printf("[%9.1f s] %5.1f fps | RGB %3ld %3ld %3ld | OSC %llu packets, %llu values, %llu suppressed | "
+        "late p99 us: capture %.0f, smoothing %.0f, OSC %.0f\n",
+        elapsedSeconds, fps,
+        std::lround(output.color.r * 255.0f), std::lround(output.color.g * 255.0f), std::lround(output.color.b * 255.0f),
+        static_cast<unsigned long long>(oscStats.sentPackets),
+        static_cast<unsigned long long>(oscStats.sentMessages),
+        static_cast<unsigned long long>(oscStats.suppressedMessages),
+        output.captureStats.p99LatenessUs, output.smoothingStats.p99LatenessUs, output.oscStats.p99LatenessUs);
+
+    uint64_t skippedDeadlines = output.captureStats.skippedDeadlines +
+        output.smoothingStats.skippedDeadlines + output.oscStats.skippedDeadlines;
+    if (skippedDeadlines > 0) {
+        std::printf("  Skipped deadlines: %llu\n", static_cast<unsigned long long>(skippedDeadlines));
+    }
+    if (settings.oscAsync && (oscStats.droppedSamples > 0 || oscStats.coalescedSamples > 0)) {
+        std::printf("  OSC queue: %zu deep | coalesced: %llu | dropped: %llu\n", oscStats.queueDepth,
+            static_cast<unsigned long long>(oscStats.coalescedSamples),
+            static_cast<unsigned long long>(oscStats.droppedSamples));
+    }
+
+    // Only destinations with delivery problems, destination 0 is 127.0.0.1:oscPort
+    size_t destinationCount = oscManager.GetDestinationCount();
+    for (size_t i = 0; i < destinationCount; i++) {
+        UdpTransport::DestinationStats destinationStats = oscManager.GetDestinationStats(i);
+        if (destinationStats.wouldBlock == 0 && destinationStats.refused == 0 && destinationStats.otherErrors == 0) {
+            continue;
+        }
+
+        std::string destinationName = "127.0.0.1:" + std::to_string(settings.oscPort);
+        if (i > 0 && i - 1 < settings.oscExtraDestinations.size()) {
+            const OscDestination& destination = settings.oscExtraDestinations[i - 1];
+            destinationName = destination.address + ":" + std::to_string(destination.port);
+        }
+        std::printf("  %s: %llu sent | full: %llu, refused: %llu, other: %llu\n", destinationName.c_str(),
+            static_cast<unsigned long long>(destinationStats.sentPackets),
+            static_cast<unsigned long long>(destinationStats.wouldBlock),
+            static_cast<unsigned long long>(destinationStats.refused),
+            static_cast<unsigned long long>(destinationStats.otherErrors));
+    }
+
+    UdpTransport::Stats transportStats = oscManager.GetTransportStats();
+    if (transportStats.fatalErrors > 0) {
+        std::printf("  Socket failures: %llu (opened %llu times)\n",
+            static_cast<unsigned long long>(transportStats.fatalErrors),
+            static_cast<unsigned long long>(transportStats.openAttempts));
+    }
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+    HeadlessOptions options;
+    bool showHelp = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            showHelp = true;
+        }
+        if (arg == "--defaults") {
+            options.useSavedSettings = false;
+        }
+    }
+
+    UserSettings settings = options.useSavedSettings ? UserSettings::Load() : UserSettings();
+    bool validArguments = showHelp || ParseArguments(argc, argv, settings, options);
+
+    // Registering creates nothing, only the selected source is constructed below
+    FrameSourceRegistry frameSources;
+    frameSources.Register("pattern", "Solid colour cycling through every hue (--pattern-period)", [&options]() {
+        return std::unique_ptr<IFrameSource>(new TestPatternSource(options.patternPeriod));
+    });
+    frameSources.Register("replay", "Frames recorded with --record (--replay, --replay-speed)", [&options]() {
+        return std::unique_ptr<IFrameSource>(new ReplayFrameSource(options.replay, options.replaySpeed, options.replayLoop));
+    });
+#ifdef _WIN32
+    HeadlessCaptureContext captureContext(options.window, settings.keepTargetWindowOnTop);
+    RegisterWindowsFrameSources(frameSources, captureContext.GetContext());
+#endif
+
+    if (showHelp || !validArguments) {
+        PrintUsage(argv[0], frameSources);
+        return showHelp ? 0 : 2;
+    }
+
+    if (options.source.empty() && !options.replay.empty()) {
+        options.source = "replay";
+    }
+
+    // The backend the settings ask for, and the settings follow a backend picked on the command line
+#ifdef _WIN32
+    bool captureBackend = options.source != "pattern" && options.source != "replay";
+    if (options.source.empty()) {
+        options.source = settings.GetCaptureSourceName();
+    }
+    else if (captureBackend) {
+        settings.enableSpout = options.source == "spout";
+        settings.useDXGI = options.source == "dxgi";
+    }
+#else
+    if (options.source.empty()) {
+        options.source = "pattern";
+    }
+#endif
+
+    std::unique_ptr<IFrameSource> source = frameSources.Create(options.source);
+    if (!source) {
+        std::string names;
+        for (const std::string& name : frameSources.GetNames()) {
+            names += (names.empty() ? "" : ", ") + name;
+        }
+        std::fprintf(stderr, "Unknown source \"%s\", available: %s\n", options.source.c_str(), names.c_str());
+        return 2;
+    }
+
+    if (options.saveSettings) {
+        settings.Save();
+    }
+
+    std::string error;
+#ifdef _WIN32
+    // Windows Graphics Capture and Spout capture on it, it is never presented
+    if (captureBackend && !captureContext.CreateDevice(error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+#endif
+    if (!source->Open(error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    OscManager oscManager("127.0.0.1", settings.oscPort);
+    oscManager.ApplySettings(settings);
+
+    std::signal(SIGINT, OnStopSignal);
+    std::signal(SIGTERM, OnStopSignal);
+
+    FrameRecorder recorder;
+    if (!options.record.empty() && !recorder.Open(options.record)) {
+        std::fprintf(stderr, "Could not create recording \"%s\"\n", options.record.c_str());
+        return 1;
+    }
+
+    PipelineThread pipeline(oscManager);
+    if (recorder.IsOpen()) {
+        pipeline.SetRecorder(&recorder);
+    }
+    pipeline.Start(settings, *source);
+
+    std::string captureRate = source->IsPaced() ? "at " + std::to_string(settings.captureFps) + " fps" : "as fast as it delivers";
+    std::printf("Capturing from %s %s, sending OSC to 127.0.0.1:%d at %d Hz\n",
+        options.source.c_str(), captureRate.c_str(), settings.oscPort, settings.oscRate);
+    std::fflush(stdout);
+
+    Clock::time_point startTime = Clock::now();
+    Clock::time_point endTime = options.duration > 0.0 ?
+        startTime + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration)) :
+        Clock::time_point::max();
+    auto statsInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.statsInterval));
+    Clock::time_point nextStatsTime = startTime + statsInterval;
+    Clock::time_point lastStatsTime = startTime;
+    uint64_t lastFrameCount = 0;
+
+    while (!stopRequested && Clock::now() < endTime) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        // Always-on: reopen a lost source rather than exit, except for a replay that has ended
+        if (pipeline.IsSourceLost() && options.source == "replay" && !options.replayLoop) {
+            std::printf("Replay finished\n");
+            break;
+        }
+        if (pipeline.IsSourceLost()) {
+            pipeline.Stop();
+            source->Close();
+            std::printf("Source lost, reopening\n");
+            std::fflush(stdout);
+
+            Clock::time_point retryTime = Clock::now() + std::chrono::seconds(1);
+            while (!stopRequested && Clock::now() < retryTime) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            if (stopRequested) {
+                break;
+            }
+
+            if (source->Open(error)) {
+                pipeline.Start(settings, *source);
+            }
+            else {
+                std::fprintf(stderr, "%s, retrying\n", error.c_str());
+            }
+            continue;
+        }
+
+        Clock::time_point now = Clock::now();
+        if (options.statsInterval > 0.0 && now >= nextStatsTime) {
+            pipeline.UpdateOutput();
+            const PipelineThread::Output& output = pipeline.GetOutput();
+            double fps = (output.frameCount - lastFrameCount) / std::chrono::duration<double>(now - lastStatsTime).count();
+            PrintStats(std::chrono::duration<double>(now - startTime).count(), fps, output, oscManager, settings);
+
+            lastFrameCount = output.frameCount;
+            lastStatsTime = now;
+            nextStatsTime += statsInterval;
+        }
+    }
+
+    pipeline.Stop();
+    source->Close();
+
+    if (options.statsInterval > 0.0) {
+        Clock::time_point now = Clock::now();
+        pipeline.UpdateOutput();
+        const PipelineThread::Output& output = pipeline.GetOutput();
+        double fps = (output.frameCount - lastFrameCount) / std::chrono::duration<double>(now - lastStatsTime).count();
+        PrintStats(std::chrono::duration<double>(now - startTime).count(), fps, output, oscManager, settings);
+    }
+    if (!options.record.empty()) {
+        // A recorder that is already closed stopped when the file could not grow
+        std::printf("Recorded %llu frames to %s%s\n", static_cast<unsigned long long>(recorder.GetFrameCount()),
+            options.record.c_str(), recorder.IsOpen() ? "" : ", stopped early because the file could not grow");
+        recorder.Close();
+    }
+    return 0;
+}
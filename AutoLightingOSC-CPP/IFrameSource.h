@@ -0,0 +1,48 @@
+// IFrameSource.h
+#pragma once
+
+#include <chrono>
+#include <string>
+#include "ColorProcessor.h" // For Bitmap struct
+
+enum class CaptureResult {
+    Captured,
+    NoFrame,   // Nothing to process this time, tried again at the next capture
+    SourceLost // The source stopped delivering frames and has to be opened again
+};
+
+struct CapturedFrame {
+    Bitmap bitmap;                                   // Pixels from the FramePool
+    std::chrono::steady_clock::time_point timestamp; // When the source captured it
+    PixelRect crop = { 0, 0, 0, 0 };                 // Area to average that came with the frame (a
+                                                     // replayed recording), empty to use the UI's
+};
+
+// A backend frames are captured from: a screen capture API, a frame sharing receiver, a test
+// pattern. Open and Close are called while nothing captures from it, AcquireFrame and
+// ReleaseFrame from the one thread that captures, one frame at a time.
+class IFrameSource {
+public:
+    virtual ~IFrameSource() {}
+
+    // Gets ready to capture, false with a message for the user when it cannot
+    virtual bool Open(std::string& error) = 0;
+    virtual void Close() = 0;
+
+    // Fills frame with the next frame
+    virtual CaptureResult AcquireFrame(CapturedFrame& frame) = 0;
+    // Done with the frame, its buffer can go back to the pool
+    virtual void ReleaseFrame(CapturedFrame& frame) { frame.bitmap = Bitmap(); }
+
+    // Pixel format of the frames it delivers, of the last frame when it depends on the sender
+    virtual PixelFormat GetFormat() const { return PixelFormat::BGRA8; }
+
+    // False when captures should run back to back instead of at the capture rate, for a source
+    // that has every frame ready and delivers each one once (a replay at maximum speed)
+    virtual bool IsPaced() const { return true; }
+
+    // What it is connected to (e.g. a Spout sender), empty when that is not known. Like
+    // AcquireFrame, only called from the capturing thread while it runs: PipelineThread
+    // publishes it in its Output for the UI.
+    virtual std::string GetDescription() const { return std::string(); }
+};
@@ -0,0 +1,130 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// IntegralImage.cpp
+
+#include "IntegralImage.h"
+#include <algorithm>
+
+IntegralImage::IntegralImage()
+    : width(0), height(0), useWideSums(false), format(PixelFormat::BGRA8) {
+}
+
+void IntegralImage::Build(const BitmapView& bitmap) {
+    if (!bitmap.IsValid()) {
+        Clear();
+        return;
+    }
+
+    width = bitmap.width;
+    height = bitmap.height;
+    format = bitmap.format;
+
+    // A full frame of 255s has to fit for 32-bit sums to stay exact
+    useWideSums = static_cast<uint64_t>(width) * height * 255 > UINT32_MAX;
+
+    if (useWideSums) {
+        sums32.clear();
+        BuildTable(bitmap, sums64);
+    }
+    else {
+        sums64.clear();
+        BuildTable(bitmap, sums32);
+    }
+}
+
+void IntegralImage::Clear() {
+    width = 0;
+    height = 0;
+
+    // Release the storage, a 4K table is around 100 MB
+    std::vector<uint32_t>().swap(sums32);
+    std::vector<uint64_t>().swap(sums64);
+}
+
+template <typename T>
+void IntegralImage::BuildTable(const BitmapView& bitmap, std::vector<T>& table) {
+    const size_t tableStride = (static_cast<size_t>(bitmap.width) + 1) * 3;
+    table.resize(tableStride * (static_cast<size_t>(bitmap.height) + 1));
+
+    // Top row and left column are zero so lookups never need bounds checks
+    std::fill(table.begin(), table.begin() + tableStride, T(0));
+
+    for (int y = 0; y < bitmap.height; y++) {
+        const uint8_t* src = bitmap.data + static_cast<size_t>(y) * bitmap.stride;
+        const T* above = table.data() + static_cast<size_t>(y) * tableStride;
+        T* out = table.data() + (static_cast<size_t>(y) + 1) * tableStride;
+
+        out[0] = out[1] = out[2] = 0;
+
+        T row0 = 0, row1 = 0, row2 = 0;
+        for (int x = 0; x < bitmap.width; x++) {
+            row0 += src[x * 4 + 0];
+            row1 += src[x * 4 + 1];
+            row2 += src[x * 4 + 2];
+
+            size_t i = (static_cast<size_t>(x) + 1) * 3;
+            out[i + 0] = above[i + 0] + row0;
+            out[i + 1] = above[i + 1] + row1;
+            out[i + 2] = above[i + 2] + row2;
+        }
+    }
+}
+
+template <typename T>
+ChannelSums IntegralImage::LookupRect(const std::vector<T>& table, int tableWidth, const PixelRect& rect) {
+    const size_t tableStride = (static_cast<size_t>(tableWidth) + 1) * 3;
+    const T* topLeft = table.data() + rect.top * tableStride + rect.left * 3;
+    const T* topRight = table.data() + rect.top * tableStride + rect.right * 3;
+    const T* bottomLeft = table.data() + rect.bottom * tableStride + rect.left * 3;
+    const T* bottomRight = table.data() + rect.bottom * tableStride + rect.right * 3;
+
+    // Unsigned wrap-around cancels out, the result is exact as long as the rect sum fits in T
+    ChannelSums sums;
+    sums.c0 = static_cast<T>(bottomRight[0] - bottomLeft[0] - topRight[0] + topLeft[0]);
+    sums.c1 = static_cast<T>(bottomRight[1] - bottomLeft[1] - topRight[1] + topLeft[1]);
+    sums.c2 = static_cast<T>(bottomRight[2] - bottomLeft[2] - topRight[2] + topLeft[2]);
+    return sums;
+}
+
+PixelRect IntegralImage::ClampRect(const PixelRect& rect) const {
+    PixelRect clamped;
+    clamped.left = std::clamp(rect.left, 0, width);
+    clamped.right = std::clamp(rect.right, clamped.left, width);
+    clamped.top = std::clamp(rect.top, 0, height);
+    clamped.bottom = std::clamp(rect.bottom, clamped.top, height);
+    return clamped;
+}
+
+ChannelSums IntegralImage::GetSums(const PixelRect& rect, long long& pixelCount) const {
+    if (!IsValid()) {
+        pixelCount = 0;
+        return ChannelSums();
+    }
+
+    PixelRect clamped = ClampRect(rect);
+    pixelCount = static_cast<long long>(clamped.right - clamped.left) * (clamped.bottom - clamped.top);
+
+    if (useWideSums) {
+        return LookupRect(sums64, width, clamped);
+    }
+    return LookupRect(sums32, width, clamped);
+}
@@ -0,0 +1,46 @@
+// IntegralImage.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "ColorProcessor.h" // For BitmapView, PixelRect
+#include "PixelKernels.h"   // For ChannelSums
+
+// Per-channel summed-area table over a 4-byte-per-pixel image.
+// Built once per frame, after which the sums of any rectangle cost four lookups.
+class IntegralImage {
+private:
+    int width;
+    int height;
+    bool useWideSums;
+    PixelFormat format;
+
+    // (width + 1) * (height + 1) entries of three interleaved channel sums.
+    // 32-bit sums are used whenever a whole frame cannot overflow them (up to ~4K).
+    std::vector<uint32_t> sums32;
+    std::vector<uint64_t> sums64;
+
+    template <typename T>
+    static void BuildTable(const BitmapView& bitmap, std::vector<T>& table);
+
+    template <typename T>
+    static ChannelSums LookupRect(const std::vector<T>& table, int tableWidth, const PixelRect& rect);
+
+public:
+    IntegralImage();
+
+    // Rebuilds the table for bitmap, reusing the existing storage when possible
+    void Build(const BitmapView& bitmap);
+    void Clear();
+
+    bool IsValid() const { return width > 0 && height > 0; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+    PixelFormat GetFormat() const { return format; }
+
+    // Clamps rect to the image
+    PixelRect ClampRect(const PixelRect& rect) const;
+
+    // Channel sums (in the byte order of GetFormat) and pixel count of rect, clamped to the image
+    ChannelSums GetSums(const PixelRect& rect, long long& pixelCount) const;
+};
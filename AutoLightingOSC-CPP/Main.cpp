@@ -25,6 +25,7 @@
 
 #include <windows.h>
 #include <d3d11.h>
+#include <d3d11_4.h>
 #include <tchar.h>
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -32,17 +33,20 @@
 #include <string>
 #include <memory>
 #include <chrono>
+#include <atomic>
 #include <algorithm>
+#include <cmath>
+#include <iostream>
 #include <shellapi.h>
 
 #include "Resource.h"
 #include "UserSettings.h"
 #include "WindowManager.h"
-#include "ScreenCapture.h"
 #include "ColorProcessor.h"
+#include "PipelineThread.h"
 #include "OscManager.h"
-#include "SpoutReceiver.h"
-#include "WindowsGraphicsCapture.h"
+#include "FrameSourceRegistry.h"
+#include "WindowsFrameSources.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -64,14 +68,19 @@ LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 // Application state
 struct AppState {
     UserSettings settings;
-    std::unique_ptr<WindowsGraphicsCapture> windowsGraphicsCapture;
     std::unique_ptr<WindowManager> windowManager;
-    std::unique_ptr<ScreenCapture> screenCapture;
-    std::unique_ptr<ColorProcessor> colorProcessor;
     std::unique_ptr<OscManager> oscManager;
-    std::unique_ptr<SpoutReceiver> spoutReceiver;
+    std::unique_ptr<PipelineThread> pipelineThread;
+
+    // Capture backends by name, only the selected one is created, when capture starts
+    WindowsCaptureContext captureContext;
+    FrameSourceRegistry frameSources;
+    std::unique_ptr<IFrameSource> frameSource;
+    std::string frameSourceName;
 
     HWND targetWindowHandle = nullptr;
+    // targetWindowHandle as last handed to the pipeline thread
+    std::atomic<HWND> captureWindow{ nullptr };
     RECT captureArea = { 0, 0, 0, 0 };
     RECT userCropArea = { 0, 0, 0, 0 };
     bool isCapturing = false;
@@ -80,24 +89,21 @@ struct AppState {
     bool isActivelySelecting = false;
     ImVec2 startPoint = { 0, 0 };
 
-    ColorRGB currentColor = { 0, 0, 0 };
-    ColorRGB targetColor = { 0, 0, 0 };
-    std::chrono::steady_clock::time_point lastCaptureTime;
-    std::chrono::steady_clock::time_point lastSmoothingTime;
-
     // Window list for the combobox
     std::vector<WindowInfo> windowList;
     int selectedWindowIdx = -1;
 
-    // Capture and OSC timer variables
-    std::chrono::steady_clock::time_point lastFrameTime;
-    std::chrono::milliseconds captureInterval{ 200 }; // Default 5 FPS (1000/5)
-    std::chrono::milliseconds oscInterval{ 200 };     // Default 5 Hz
-    const std::chrono::microseconds smoothingInterval{ 16667 }; // ~60fps (1000000/60)
-
-    // Texture for preview
+    // Texture for preview, and the size of the captured frame it shows
     ID3D11ShaderResourceView* previewTexture = nullptr;
-    Bitmap lastCapturedImage;
+    int lastFrameWidth = 0;
+    int lastFrameHeight = 0;
+
+    // Size the debug view last displayed the preview at, the pipeline decimates frames to it
+    int previewDisplayWidth = 960;
+    int previewDisplayHeight = 540;
+
+    PixelRect liveSelectionArea = { 0, 0, 0, 0 };
+    PipelineThread::Input publishedInput;
 
     // Auto Capture
     bool vrchatWasDetected = false;
@@ -116,41 +122,35 @@ struct AppState {
 
     AppState() {
         windowManager = std::make_unique<WindowManager>();
-        screenCapture = std::make_unique<ScreenCapture>();
-        windowsGraphicsCapture = std::make_unique<WindowsGraphicsCapture>();
 
         // Load settings
         settings = UserSettings::Load();
 
-        colorProcessor = std::make_unique<ColorProcessor>(settings);
-
         // Create OSC Manager
         oscManager = std::make_unique<OscManager>("127.0.0.1", settings.oscPort);
-        oscManager->SetParameters(
-            settings.oscRParameter,
-            settings.oscGParameter,
-            settings.oscBParameter
-        );
+        oscManager->ApplySettings(settings);
 
-        spoutReceiver = std::make_unique<SpoutReceiver>();
+        // Capture, smoothing and OSC output run on their own thread while capturing
+        pipelineThread = std::make_unique<PipelineThread>(*oscManager);
 
-        // Set intervals based on settings
-        captureInterval = std::chrono::milliseconds(1000 / settings.captureFps);
-        oscInterval = std::chrono::milliseconds(1000 / settings.oscRate);
-
-        lastFrameTime = std::chrono::steady_clock::now();
-        lastCaptureTime = std::chrono::steady_clock::now();
-        lastSmoothingTime = std::chrono::steady_clock::now();
+        // The pipeline thread captures captureWindow, the target as last handed to it
+        captureContext.windowManager = windowManager.get();
+        captureContext.device = g_pd3dDevice;
+        captureContext.deviceContext = g_pd3dDeviceContext;
+        captureContext.getWindow = [this]() { return captureWindow.load(); };
+        RegisterWindowsFrameSources(frameSources, captureContext);
     }
 
     ~AppState() {
+        pipelineThread->Stop();
+
         if (previewTexture) {
             previewTexture->Release();
             previewTexture = nullptr;
         }
 
-        if (spoutReceiver && spoutReceiver->IsConnected()) {
-            spoutReceiver->Disconnect();
+        if (frameSource) {
+            frameSource->Close();
         }
 
         if (logoTexture) {
@@ -202,213 +202,103 @@ struct AppState {
     }
 
     void StartCapture() {
-        // Set up capture interval based on FPS
-        captureInterval = std::chrono::milliseconds(1000 / settings.captureFps);
-
         // Failsafe, read and apply OSC config before starting capture
-        oscManager->SetOscPort(settings.oscPort);
-        oscManager->SetParameters(
-            settings.oscRParameter,
-            settings.oscGParameter,
-            settings.oscBParameter
-        );
-
-        oscManager->SetOscRate(settings.oscRate);
-        oscInterval = std::chrono::milliseconds(1000 / settings.oscRate);
-
-        // If using Spout, try to connect to a sender
-        if (settings.enableSpout) {
-            if (spoutReceiver->Connect()) {
-                // Successfully connected to a Spout sender
-                isCapturing = true;
-            }
-            else {
-                // Failed to connect to any Spout sender
-                MessageBoxA(nullptr, "Could not connect to any Spout sender. Please ensure a Spout sender is running.",
-                    "Error", MB_OK | MB_ICONERROR);
-                return;
-            }
+        oscManager->ApplySettings(settings);
+
+        // Window capture backends need a target, look for VRChat if none is selected
+        if (!targetWindowHandle) {
+            FindTargetWindow();
         }
-        else {
-            // Using normal screen capture
-            if (!targetWindowHandle) {
-                FindTargetWindow();
-                if (!targetWindowHandle) {
-                    // Show error message
-                    MessageBoxA(nullptr, "Could not find VRChat window. Please make sure VRChat is running, or select another target application in the options.",
-                        "Error", MB_OK | MB_ICONERROR);
-                    return;
-                }
-            }
+        PublishPipelineInput();
 
-            // Start capture with appropriate method
-            if (settings.keepTargetWindowOnTop) {
-                windowManager->SetWindowOnTop(targetWindowHandle);
-            }
+        // Create the selected backend the first time it is used, or when the selection changed
+        std::string sourceName = settings.GetCaptureSourceName();
+        if (!frameSource || frameSourceName != sourceName) {
+            frameSource = frameSources.Create(sourceName);
+            frameSourceName = sourceName;
+        }
 
-            if (!settings.useDXGI) {
-                // Initialize Windows Graphics Capture
-                windowsGraphicsCapture->SetDevice(g_pd3dDevice, g_pd3dDeviceContext);
-                windowsGraphicsCapture->StartCaptureWindow(targetWindowHandle);
-            }
+        std::string error = "Unknown capture source \"" + sourceName + "\".";
+        if (!frameSource || !frameSource->Open(error)) {
+            MessageBoxA(nullptr, error.c_str(), "Error", MB_OK | MB_ICONERROR);
+            return;
+        }
 
-            isCapturing = true;
+        if (settings.keepTargetWindowOnTop && targetWindowHandle) {
+            windowManager->SetWindowOnTop(targetWindowHandle);
         }
+
+        isCapturing = true;
         userManuallyStopped = false;
-        lastFrameTime = std::chrono::steady_clock::now();
-        lastSmoothingTime = std::chrono::steady_clock::now();
+        pipelineThread->Start(settings, *frameSource);
     }
 
     void StopCapture() {
+        // The pipeline thread uses the capture backends, stop it before tearing them down
+        pipelineThread->Stop();
+
         // Set flag to indicate manual stop if this is during active VRChat session
         if (isCapturing && windowManager->FindVRChatWindow() != nullptr && settings.autoCapture) {
             userManuallyStopped = true;
         }
-        // If using Spout, disconnect from sender
-        if (settings.enableSpout) {
-            spoutReceiver->Disconnect();
+        if (frameSource) {
+            frameSource->Close();
         }
-        else {
-            // Not using Spout
 
-            // Stop Windows Graphics Capture if that's what we're using
-            if (!settings.useDXGI) {
-                windowsGraphicsCapture->StopCapture();
-            }
-
-            // Restore window state if we have a target window
-            if (targetWindowHandle) {
-                windowManager->SetWindowNotTopMost(targetWindowHandle);
-            }
+        // Restore window state if we have a target window
+        if (targetWindowHandle) {
+            windowManager->SetWindowNotTopMost(targetWindowHandle);
         }
 
         isCapturing = false;
     }
 
-    void PerformCapture() {
-        Bitmap capturedBitmap;
-
-        if (settings.enableSpout) {
-            // Check if the sender is still actively sending frames
-            if (!spoutReceiver->IsSenderActive()) {
-                // std::cerr << "Spout sender inactive, reconnecting..." << std::endl;
-                spoutReceiver->Disconnect();
-                Sleep(1000); // Brief delay
-
-                if (!spoutReceiver->Connect()) {
-                    // std::cerr << "Failed to reconnect to Spout sender, retrying..." << std::endl;
-                    return;
-                }
-            }
-
-            // Get frame from Spout
-            capturedBitmap = spoutReceiver->Receive();
-            if (!capturedBitmap.IsValid()) {
-                static int failCount = 0;
-                failCount++;
-
-                // Only disconnect after multiple consecutive failures
-                if (failCount > 10 && spoutReceiver->IsConnected()) {
-                    spoutReceiver->Disconnect();
-                    MessageBoxA(nullptr, "Spout sender disconnected after multiple failures.",
-                        "Warning", MB_OK | MB_ICONWARNING);
-                    StopCapture();
-                    failCount = 0;
-                }
-                return;
-            }
-        }
-        else {
-            // Use normal screen capture
-            if (!windowManager->IsWindowValid(targetWindowHandle)) {
-                return;
-            }
-
-            // Update the capture area each time to follow the window
-            captureArea = windowManager->GetOptimalCaptureArea(targetWindowHandle);
+    // Hands the capture window, crop and preview size to the pipeline thread when they change
+    void PublishPipelineInput() {
+        captureWindow = targetWindowHandle;
 
-            if (settings.useDXGI) {
-                // Use DXGI capture
-                capturedBitmap = screenCapture->Capture(captureArea);
-            }
-            else {
-                // Use Windows Capture API
-                if (!windowsGraphicsCapture->GetCaptureWindow() ||
-                    windowsGraphicsCapture->GetCaptureWindow() != targetWindowHandle) {
-                    windowsGraphicsCapture->SetDevice(g_pd3dDevice, g_pd3dDeviceContext);
-                    windowsGraphicsCapture->StartCaptureWindow(targetWindowHandle);
-                }
-                capturedBitmap = windowsGraphicsCapture->Capture(captureArea);
-            }
+        PipelineThread::Input input;
 
-            if (!capturedBitmap.IsValid()) {
-                return;
-            }
+        // Determine if we should use a crop for color processing.
+        // While dragging a new selection the live selection is used instead of the saved crop.
+        PixelRect cropRect = isActivelySelecting ? liveSelectionArea : ToPixelRect(userCropArea);
+        if (isDebugViewExpanded &&
+            cropRect.right > cropRect.left &&
+            cropRect.bottom > cropRect.top) {
+            input.crop = cropRect;
+            input.liveSelection = isActivelySelecting;
         }
 
-        // Save the last captured image for preview
-        lastCapturedImage = capturedBitmap;
-
-        // Create or update preview texture
         if (isDebugViewExpanded) {
-            UpdatePreviewTexture(capturedBitmap);
+            input.previewWidth = previewDisplayWidth;
+            input.previewHeight = previewDisplayHeight;
         }
 
-        // Determine if we should use a crop for color processing
-        bool useCrop = !isActivelySelecting &&
-            userCropArea.right > userCropArea.left &&
-            userCropArea.bottom > userCropArea.top &&
-            isDebugViewExpanded;
-
-        // Process image to get average color
-        Bitmap processingBitmap;
-
-        if (useCrop) {
-            // Only extract the cropped portion for color processing
-            // instead of capturing again
-            RECT validCrop = userCropArea;
-            validCrop.left = std::max(0L, validCrop.left);
-            validCrop.top = std::max(0L, validCrop.top);
-            validCrop.right = std::min((LONG)lastCapturedImage.width, validCrop.right);
-            validCrop.bottom = std::min((LONG)lastCapturedImage.height, validCrop.bottom);
-
-            int cropWidth = validCrop.right - validCrop.left;
-            int cropHeight = validCrop.bottom - validCrop.top;
-
-            if (cropWidth > 0 && cropHeight > 0) {
-                // Create a new bitmap with just the cropped area
-                processingBitmap = Bitmap(cropWidth, cropHeight);
-
-                // Copy just the cropped region from the full image
-                for (int y = 0; y < cropHeight; y++) {
-                    for (int x = 0; x < cropWidth; x++) {
-                        int srcOffset = (validCrop.top + y) * lastCapturedImage.stride + (validCrop.left + x) * 4;
-                        int dstOffset = y * processingBitmap.stride + x * 4;
-
-                        // Copy the pixel data (BGRA format)
-                        processingBitmap.data.get()[dstOffset + 0] = lastCapturedImage.data.get()[srcOffset + 0]; // B
-                        processingBitmap.data.get()[dstOffset + 1] = lastCapturedImage.data.get()[srcOffset + 1]; // G
-                        processingBitmap.data.get()[dstOffset + 2] = lastCapturedImage.data.get()[srcOffset + 2]; // R
-                        processingBitmap.data.get()[dstOffset + 3] = lastCapturedImage.data.get()[srcOffset + 3]; // A
-                    }
-                }
-            }
+        if (input != publishedInput) {
+            pipelineThread->SetInput(input);
+            publishedInput = input;
         }
+    }
 
-        // If we didn't create a valid crop bitmap, use the full image
-        if (!processingBitmap.IsValid()) {
-            processingBitmap = lastCapturedImage;
-        }
+    // Takes the newest colour and preview from the pipeline thread
+    void ReadPipelineOutput() {
+        pipelineThread->UpdateOutput();
 
-        auto downscaledBitmap = colorProcessor->DownscaleForProcessing(processingBitmap);
-        auto avgColor = colorProcessor->GetAverageColor(downscaledBitmap);
+        if (pipelineThread->UpdatePreview()) {
+            const PipelineThread::Preview& preview = pipelineThread->GetPreview();
+            lastFrameWidth = preview.frameWidth;
+            lastFrameHeight = preview.frameHeight;
+            UpdatePreviewTexture(preview.image);
+        }
+    }
 
-        // Store the target color (before smoothing)
-        targetColor = colorProcessor->ProcessColor(avgColor);
+    static PixelRect ToPixelRect(const RECT& rect) {
+        return { static_cast<int>(rect.left), static_cast<int>(rect.top),
+            static_cast<int>(rect.right), static_cast<int>(rect.bottom) };
     }
 
     RECT ScaleUserCropToActualWindow() {
-        if (!lastCapturedImage.IsValid()) {
+        if (lastFrameWidth <= 0 || lastFrameHeight <= 0) {
             return captureArea; // Return full area if no image available
         }
 
@@ -419,12 +309,12 @@ struct AppState {
         RECT validCrop = userCropArea;
         validCrop.left = std::max(0L, validCrop.left);
         validCrop.top = std::max(0L, validCrop.top);
-        validCrop.right = std::min((LONG)lastCapturedImage.width, validCrop.right);
-        validCrop.bottom = std::min((LONG)lastCapturedImage.height, validCrop.bottom);
+        validCrop.right = std::min((LONG)lastFrameWidth, validCrop.right);
+        validCrop.bottom = std::min((LONG)lastFrameHeight, validCrop.bottom);
 
         // Calculate scale factors between preview and actual capture
-        float scaleX = (float)captureWidth / lastCapturedImage.width;
-        float scaleY = (float)captureHeight / lastCapturedImage.height;
+        float scaleX = (float)captureWidth / lastFrameWidth;
+        float scaleY = (float)captureHeight / lastFrameHeight;
 
         // Calculate the crop area in actual window coordinates
         RECT scaledRect;
@@ -436,6 +326,7 @@ struct AppState {
         return scaledRect;
     }
 
+    // Uploads an RGBA8 preview published by the pipeline thread
     void UpdatePreviewTexture(const Bitmap& bitmap) {
         // If texture exists but size is wrong, recreate it
         if (previewTexture) {
@@ -486,26 +377,11 @@ struct AppState {
             if (texture) {
                 D3D11_MAPPED_SUBRESOURCE mapped;
                 if (SUCCEEDED(g_pd3dDeviceContext->Map(texture, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
-                    // Copy pixel data
-                    for (UINT y = 0; y < bitmap.height; y++) {
-                        for (UINT x = 0; x < bitmap.width; x++) {
-                            int srcOffset = y * bitmap.stride + x * 4;
-                            int destOffset = y * mapped.RowPitch + x * 4;
-
-                            if (settings.enableSpout) {
-                                // Direct copy without channel swap
-                                ((BYTE*)mapped.pData)[destOffset + 0] = bitmap.data.get()[srcOffset + 0]; // B
-                                ((BYTE*)mapped.pData)[destOffset + 1] = bitmap.data.get()[srcOffset + 1]; // G
-                                ((BYTE*)mapped.pData)[destOffset + 2] = bitmap.data.get()[srcOffset + 2]; // R
-                                ((BYTE*)mapped.pData)[destOffset + 3] = bitmap.data.get()[srcOffset + 3]; // A
-                            } else {
-                                // Swap R and B channels (0=B, 1=G, 2=R, 3=A)
-                                ((BYTE*)mapped.pData)[destOffset + 0] = bitmap.data.get()[srcOffset + 2]; // B <- R
-                                ((BYTE*)mapped.pData)[destOffset + 1] = bitmap.data.get()[srcOffset + 1]; // G <- G
-                                ((BYTE*)mapped.pData)[destOffset + 2] = bitmap.data.get()[srcOffset + 0]; // R <- B
-                                ((BYTE*)mapped.pData)[destOffset + 3] = bitmap.data.get()[srcOffset + 3]; // A <- A
-                            }
-                        }
+                    // The preview is already RGBA8, only the row pitch can differ
+                    for (int y = 0; y < bitmap.height; y++) {
+                        memcpy(static_cast<BYTE*>(mapped.pData) + static_cast<size_t>(y) * mapped.RowPitch,
+                            bitmap.data.get() + static_cast<size_t>(y) * bitmap.stride,
+                            static_cast<size_t>(bitmap.width) * 4);
                     }
 
                     g_pd3dDeviceContext->Unmap(texture, 0);
@@ -515,26 +391,9 @@ struct AppState {
         }
     }
 
-    void UpdateSmoothing(float deltaTime) {
-        if (!isCapturing) return;
-
-        if (settings.enableSmoothing) {
-            currentColor = colorProcessor->GetSmoothedColor(deltaTime, targetColor);
-        }
-        else {
-            currentColor = targetColor;
-        }
-    }
-
-    void ProcessOscOutput() {
-        if (!isCapturing) return;
-
-        // Send OSC message with current color (smoothed or direct)
-        oscManager->SendColorValues(currentColor.r, currentColor.g, currentColor.b);
-    }
-
     void SaveSettings() {
         settings.Save();
+        pipelineThread->SetSettings(settings);
     }
 
     bool IsVRChatSelected() const {
@@ -689,10 +548,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
     // Create application state
     auto appState = std::make_unique<AppState>();
 
-    if (!appState->spoutReceiver->Init(g_pd3dDevice, g_pd3dDeviceContext)) {
-        std::cerr << "Warning: Failed to initialize Spout receiver" << std::endl;
-    }
-
     // Find VRChat window initially
     appState->FindTargetWindow();
 
@@ -851,30 +706,15 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             lastWindowCheckTime = currentTime;
         }
 
-        // Capture timer
+        // Capture, smoothing and OSC output run on the pipeline thread, this loop only hands
+        // over what the UI controls and stops capture if the thread lost its source
         if (appState->isCapturing) {
-            auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - appState->lastFrameTime);
-
-            if (elapsedTime >= appState->captureInterval) {
-                appState->PerformCapture();
-                appState->lastFrameTime = currentTime;
-            }
-
-            // Smoothing timer - runs at 60Hz independently
-            auto smoothingElapsed = std::chrono::duration_cast<std::chrono::microseconds>(currentTime - appState->lastSmoothingTime);
-            if (smoothingElapsed >= appState->smoothingInterval) {
-                float smoothingDeltaTime = std::chrono::duration<float>(smoothingElapsed).count();
-                appState->UpdateSmoothing(smoothingDeltaTime);
-                appState->lastSmoothingTime = currentTime;
-            }
-
-            // OSC Output timer
-            static auto lastOscTime = std::chrono::steady_clock::now();
-            auto oscElapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastOscTime);
+            appState->PublishPipelineInput();
 
-            if (oscElapsedTime >= appState->oscInterval) {
-                appState->ProcessOscOutput();
-                lastOscTime = currentTime;
+            if (appState->pipelineThread->IsSourceLost()) {
+                appState->StopCapture();
+                MessageBoxA(nullptr, "Spout sender disconnected after multiple failures.",
+                    "Warning", MB_OK | MB_ICONWARNING);
             }
         }
 
@@ -895,6 +735,8 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             lastUIFrame = now;
         }
 
+        appState->ReadPipelineOutput();
+
         // Start the Dear ImGui frame
         ImGui_ImplDX11_NewFrame();
         ImGui_ImplWin32_NewFrame();
@@ -939,7 +781,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 if (oscRate < 1) oscRate = 1;
                 if (oscRate > 240) oscRate = 240;
                 appState->settings.oscRate = oscRate;
-                appState->oscInterval = std::chrono::milliseconds(1000 / oscRate);
                 if (appState->isCapturing) {
                     appState->oscManager->SetOscRate(oscRate);
                     appState->SaveSettings();
@@ -959,7 +800,6 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 if (fps < 1) fps = 1;
                 if (fps > 60) fps = 60;
                 appState->settings.captureFps = fps;
-                appState->captureInterval = std::chrono::milliseconds(1000 / fps);
                 appState->SaveSettings();
             }
             ImGui::PopItemWidth();
@@ -1151,10 +991,11 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             ImGui::SetCursorPosY(90);
 
             // Create a colored rectangle
+            const ColorRGB& outputColor = appState->pipelineThread->GetOutput().color;
             ImVec4 currentColor = ImVec4(
-                appState->currentColor.r,
-                appState->currentColor.g,
-                appState->currentColor.b,
+                outputColor.r,
+                outputColor.g,
+                outputColor.b,
                 1.0f
             );
 
@@ -1208,8 +1049,11 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
             const char* statusText = nullptr;
 
             if (appState->settings.enableSpout) {
-                if (appState->spoutReceiver->IsConnected()) {
-                    spoutStatusText = "Spout: Connected to " + appState->spoutReceiver->GetSenderName();
+                // The receiver belongs to the pipeline thread, which publishes the sender name
+                std::string senderName = appState->isCapturing && appState->pipelineThread ?
+                    appState->pipelineThread->GetOutput().sourceDescription : std::string();
+                if (!senderName.empty()) {
+                    spoutStatusText = "Spout: Connected to " + senderName;
                     statusText = spoutStatusText.c_str();
                     statusColor = ImVec4(0.0f, 0.8f, 0.0f, 1.0f); // Green for connected
                 }
@@ -1265,14 +1109,15 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 ImGui::BeginGroup();
 
                 // RGB + OSC Values display
-                float oscR = appState->currentColor.r * 2 - 1;
-                float oscG = appState->currentColor.g * 2 - 1;
-                float oscB = appState->currentColor.b * 2 - 1;
+                const ColorRGB& displayColor = appState->pipelineThread->GetOutput().color;
+                float oscR = displayColor.r * 2 - 1;
+                float oscG = displayColor.g * 2 - 1;
+                float oscB = displayColor.b * 2 - 1;
 
                 ImGui::Text("RGB: (%d, %d, %d)",
-                    static_cast<int>(appState->currentColor.r * 255),
-                    static_cast<int>(appState->currentColor.g * 255),
-                    static_cast<int>(appState->currentColor.b * 255));
+                    static_cast<int>(displayColor.r * 255),
+                    static_cast<int>(displayColor.g * 255),
+                    static_cast<int>(displayColor.b * 255));
 
                 ImGui::SameLine();
                 ImGui::Text("|");
@@ -1293,6 +1138,59 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 ImGui::SameLine();
                 ImGui::Text("%.2f", oscB);
 
+                // OSC traffic counters
+                if (appState->oscManager) {
+                    OscManager::Stats oscStats = appState->oscManager->GetStats();
+                    ImGui::Text("OSC sent: %llu packets, %llu values | suppressed: %llu",
+                        static_cast<unsigned long long>(oscStats.sentPackets),
+                        static_cast<unsigned long long>(oscStats.sentMessages),
+                        static_cast<unsigned long long>(oscStats.suppressedMessages));
+                    if (appState->settings.oscAsync) {
+                        ImGui::Text("OSC queue: %zu deep | coalesced: %llu | dropped: %llu",
+                            oscStats.queueDepth,
+                            static_cast<unsigned long long>(oscStats.coalescedSamples),
+                            static_cast<unsigned long long>(oscStats.droppedSamples));
+                    }
+
+                    // Per-destination delivery, destination 0 is 127.0.0.1:oscPort
+                    size_t destinationCount = appState->oscManager->GetDestinationCount();
+                    for (size_t i = 0; i < destinationCount; i++) {
+                        UdpTransport::DestinationStats destinationStats = appState->oscManager->GetDestinationStats(i);
+                        std::string destinationName = "127.0.0.1:" + std::to_string(appState->settings.oscPort);
+                        if (i > 0 && i - 1 < appState->settings.oscExtraDestinations.size()) {
+                            const OscDestination& destination = appState->settings.oscExtraDestinations[i - 1];
+                            destinationName = destination.address + ":" + std::to_string(destination.port);
+                        }
+                        ImGui::Text("  %s: %llu sent | full: %llu, refused: %llu, other: %llu", destinationName.c_str(),
+                            static_cast<unsigned long long>(destinationStats.sentPackets),
+                            static_cast<unsigned long long>(destinationStats.wouldBlock),
+                            static_cast<unsigned long long>(destinationStats.refused),
+                            static_cast<unsigned long long>(destinationStats.otherErrors));
+                    }
+
+                    UdpTransport::Stats transportStats = appState->oscManager->GetTransportStats();
+                    if (transportStats.fatalErrors > 0) {
+                        ImGui::Text("  Socket failures: %llu (opened %llu times)",
+                            static_cast<unsigned long long>(transportStats.fatalErrors),
+                            static_cast<unsigned long long>(transportStats.openAttempts));
+                    }
+                }
+
+                // How late the pipeline thread's steps start after their deadlines (p99 / max)
+                if (appState->isCapturing) {
+                    const PipelineThread::Output& pipelineOutput = appState->pipelineThread->GetOutput();
+                    ImGui::Text("Late (us): capture %.0f/%.0f | smoothing %.0f/%.0f | OSC %.0f/%.0f",
+                        pipelineOutput.captureStats.p99LatenessUs, pipelineOutput.captureStats.maxLatenessUs,
+                        pipelineOutput.smoothingStats.p99LatenessUs, pipelineOutput.smoothingStats.maxLatenessUs,
+                        pipelineOutput.oscStats.p99LatenessUs, pipelineOutput.oscStats.maxLatenessUs);
+
+                    uint64_t skippedDeadlines = pipelineOutput.captureStats.skippedDeadlines +
+                        pipelineOutput.smoothingStats.skippedDeadlines + pipelineOutput.oscStats.skippedDeadlines;
+                    if (skippedDeadlines > 0) {
+                        ImGui::Text("  Skipped deadlines: %llu", static_cast<unsigned long long>(skippedDeadlines));
+                    }
+                }
+
                 ImGui::Spacing();
                 ImGui::Spacing();
 
@@ -1420,6 +1318,46 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 }
                 ImGui::PopItemWidth();
 
+                // Bundle mode, can be switched while capturing
+                bool oscUseBundles = appState->settings.oscUseBundles;
+                if (ImGui::Checkbox("Send as one OSC bundle", &oscUseBundles)) {
+                    appState->settings.oscUseBundles = oscUseBundles;
+                    if (appState->oscManager) {
+                        appState->oscManager->SetUseBundles(oscUseBundles);
+                    }
+                    appState->SaveSettings();
+                }
+
+                // Dead-band mode, can be switched while capturing
+                bool oscDeadBand = appState->settings.oscDeadBand;
+                if (ImGui::Checkbox("Only send changes", &oscDeadBand)) {
+                    appState->settings.oscDeadBand = oscDeadBand;
+                    if (appState->oscManager) {
+                        appState->oscManager->SetDeadBand(oscDeadBand,
+                            appState->settings.oscDeadBandThreshold, appState->settings.oscKeepaliveMs);
+                    }
+                    appState->SaveSettings();
+                }
+
+                // Skip updates below the precision the receiver syncs at
+                bool oscReceiverPrecision = appState->settings.oscReceiverPrecision;
+                if (ImGui::Checkbox("Only send synced steps", &oscReceiverPrecision)) {
+                    appState->settings.oscReceiverPrecision = oscReceiverPrecision;
+                    if (appState->oscManager) {
+                        appState->oscManager->SetReceiverPrecision(oscReceiverPrecision,
+                            appState->settings.oscRPrecisionBits, appState->settings.oscGPrecisionBits,
+                            appState->settings.oscBPrecisionBits);
+                    }
+                    appState->SaveSettings();
+                }
+
+                // Async sender, the thread only runs while capturing
+                bool oscAsync = appState->settings.oscAsync;
+                if (ImGui::Checkbox("Send on a background thread", &oscAsync)) {
+                    appState->settings.oscAsync = oscAsync;
+                    appState->SaveSettings(); // The pipeline thread switches the sender on or off
+                }
+
                 ImGui::Spacing();
                 ImGui::Spacing();
                 ImGui::Separator();
@@ -1524,9 +1462,9 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 // Calculate available space and aspect ratio
                 ImVec2 availRegion = ImGui::GetContentRegionAvail();
 
-                if (appState->previewTexture && appState->lastCapturedImage.IsValid()) {
+                if (appState->previewTexture && appState->lastFrameWidth > 0) {
                     // Calculate aspect ratio-correct size
-                    float aspectRatio = (float)appState->lastCapturedImage.width / appState->lastCapturedImage.height;
+                    float aspectRatio = (float)appState->lastFrameWidth / appState->lastFrameHeight;
                     ImVec2 imageSize;
 
                     if (aspectRatio > availRegion.x / availRegion.y) {
@@ -1540,6 +1478,10 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                         imageSize.x = imageSize.y * aspectRatio;
                     }
 
+                    // The next preview is generated at the size it is drawn at
+                    appState->previewDisplayWidth = std::max(1, static_cast<int>(std::ceil(imageSize.x)));
+                    appState->previewDisplayHeight = std::max(1, static_cast<int>(std::ceil(imageSize.y)));
+
                     // Left Padding of image preview
                     float offsetX = (availRegion.x - imageSize.x) * 0.0f;
                     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + offsetX);
@@ -1559,12 +1501,12 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                         float relY = mousePos.y - imagePos.y;
 
                         // Normalize to original image coordinates
-                        int imgX = static_cast<int>((relX / imageSize.x) * appState->lastCapturedImage.width);
-                        int imgY = static_cast<int>((relY / imageSize.y) * appState->lastCapturedImage.height);
+                        int imgX = static_cast<int>((relX / imageSize.x) * appState->lastFrameWidth);
+                        int imgY = static_cast<int>((relY / imageSize.y) * appState->lastFrameHeight);
 
                         // Clamp to valid image bounds
-                        imgX = std::max(0, std::min(appState->lastCapturedImage.width - 1, imgX));
-                        imgY = std::max(0, std::min(appState->lastCapturedImage.height - 1, imgY));
+                        imgX = std::max(0, std::min(appState->lastFrameWidth - 1, imgX));
+                        imgY = std::max(0, std::min(appState->lastFrameHeight - 1, imgY));
 
                         // Handle mouse down - start selection
                         if (ImGui::IsMouseClicked(ImGuiMouseButton_Left)) {
@@ -1577,6 +1519,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                         if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) && appState->isSelecting) {
                             appState->isSelecting = false;
                             appState->isActivelySelecting = false;
+                            appState->liveSelectionArea = { 0, 0, 0, 0 };
 
                             // Calculate the selection rectangle in image coordinates
                             int left = static_cast<int>(std::min(appState->startPoint.x, static_cast<float>(imgX)));
@@ -1605,18 +1548,27 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                         float relY = mousePos.y - imagePos.y;
 
                         // Normalize to image coordinates
-                        int currentImgX = static_cast<int>((relX / imageSize.x) * appState->lastCapturedImage.width);
-                        int currentImgY = static_cast<int>((relY / imageSize.y) * appState->lastCapturedImage.height);
+                        int currentImgX = static_cast<int>((relX / imageSize.x) * appState->lastFrameWidth);
+                        int currentImgY = static_cast<int>((relY / imageSize.y) * appState->lastFrameHeight);
 
                         // Clamp to image bounds
-                        currentImgX = std::max(0, std::min(appState->lastCapturedImage.width - 1, currentImgX));
-                        currentImgY = std::max(0, std::min(appState->lastCapturedImage.height - 1, currentImgY));
+                        currentImgX = std::max(0, std::min(appState->lastFrameWidth - 1, currentImgX));
+                        currentImgY = std::max(0, std::min(appState->lastFrameHeight - 1, currentImgY));
+
+                        // Track the live selection so the color follows the drag at UI rate
+                        appState->liveSelectionArea = {
+                            static_cast<int>(std::min(appState->startPoint.x, static_cast<float>(currentImgX))),
+                            static_cast<int>(std::min(appState->startPoint.y, static_cast<float>(currentImgY))),
+                            static_cast<int>(std::max(appState->startPoint.x, static_cast<float>(currentImgX))),
+                            static_cast<int>(std::max(appState->startPoint.y, static_cast<float>(currentImgY)))
+                        };
+                        appState->PublishPipelineInput();
 
                         // Convert image coordinates back to screen coordinates
-                        float startScreenX = imagePos.x + (appState->startPoint.x / appState->lastCapturedImage.width) * imageSize.x;
-                        float startScreenY = imagePos.y + (appState->startPoint.y / appState->lastCapturedImage.height) * imageSize.y;
-                        float endScreenX = imagePos.x + (static_cast<float>(currentImgX) / appState->lastCapturedImage.width) * imageSize.x;
-                        float endScreenY = imagePos.y + (static_cast<float>(currentImgY) / appState->lastCapturedImage.height) * imageSize.y;
+                        float startScreenX = imagePos.x + (appState->startPoint.x / appState->lastFrameWidth) * imageSize.x;
+                        float startScreenY = imagePos.y + (appState->startPoint.y / appState->lastFrameHeight) * imageSize.y;
+                        float endScreenX = imagePos.x + (static_cast<float>(currentImgX) / appState->lastFrameWidth) * imageSize.x;
+                        float endScreenY = imagePos.y + (static_cast<float>(currentImgY) / appState->lastFrameHeight) * imageSize.y;
 
                         // Draw selection rectangle (yellow)
                         ImGui::GetWindowDrawList()->AddRect(
@@ -1631,10 +1583,10 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                     else if (appState->userCropArea.right > appState->userCropArea.left &&
                         appState->userCropArea.bottom > appState->userCropArea.top) {
                         // Convert saved crop area from image to screen coordinates
-                        float cropLeftScreen = imagePos.x + ((float)appState->userCropArea.left / appState->lastCapturedImage.width) * imageSize.x;
-                        float cropTopScreen = imagePos.y + ((float)appState->userCropArea.top / appState->lastCapturedImage.height) * imageSize.y;
-                        float cropRightScreen = imagePos.x + ((float)appState->userCropArea.right / appState->lastCapturedImage.width) * imageSize.x;
-                        float cropBottomScreen = imagePos.y + ((float)appState->userCropArea.bottom / appState->lastCapturedImage.height) * imageSize.y;
+                        float cropLeftScreen = imagePos.x + ((float)appState->userCropArea.left / appState->lastFrameWidth) * imageSize.x;
+                        float cropTopScreen = imagePos.y + ((float)appState->userCropArea.top / appState->lastFrameHeight) * imageSize.y;
+                        float cropRightScreen = imagePos.x + ((float)appState->userCropArea.right / appState->lastFrameWidth) * imageSize.x;
+                        float cropBottomScreen = imagePos.y + ((float)appState->userCropArea.bottom / appState->lastFrameHeight) * imageSize.y;
 
                         // Draw the saved crop rectangle (red)
                         ImGui::GetWindowDrawList()->AddRect(
@@ -1859,6 +1811,13 @@ bool CreateDeviceD3D(HWND hWnd)
     if (D3D11CreateDeviceAndSwapChain(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, createDeviceFlags, featureLevelArray, 2, D3D11_SDK_VERSION, &sd, &g_pSwapChain, &g_pd3dDevice, &featureLevel, &g_pd3dDeviceContext) != S_OK)
         return false;
 
+    // Windows Graphics Capture and Spout use the immediate context from the pipeline thread
+    ID3D11Multithread* multithread = nullptr;
+    if (SUCCEEDED(g_pd3dDeviceContext->QueryInterface(__uuidof(ID3D11Multithread), reinterpret_cast<void**>(&multithread)))) {
+        multithread->SetMultithreadProtected(TRUE);
+        multithread->Release();
+    }
+
     CreateRenderTarget();
     return true;
 }
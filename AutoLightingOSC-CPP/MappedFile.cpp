@@ -0,0 +1,237 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// MappedFile.cpp
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : data(nullptr), size(0), writable(false),
+#ifdef _WIN32
+    fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {
+#else
+    fileDescriptor(-1) {
+#endif
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::OpenRead(const std::string& path) {
+    Close();
+
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    LARGE_INTEGER fileSize;
+    if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0) {
+        Close();
+        return false;
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+    writable = false;
+    if (!Map()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::OpenWrite(const std::string& path, size_t initialSize) {
+    Close();
+
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    writable = true;
+    if (!Resize(initialSize)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::Resize(size_t newSize) {
+    if (!writable || fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // A mapped file can grow but not be cut, so the old mapping is only given up first when
+    // shrinking. SetEndOfFile allocates the space, a full disk fails here with the file as it was.
+    if (newSize < size) {
+        Unmap();
+    }
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(newSize);
+    if (!SetFilePointerEx(fileHandle, position, nullptr, FILE_BEGIN) || !SetEndOfFile(fileHandle)) {
+        if (!data && size > 0) {
+            Map();
+        }
+        return false;
+    }
+
+    Unmap();
+    size = newSize;
+    return newSize == 0 || Map();
+}
+
+bool MappedFile::Map() {
+    // Copy-on-write views for reading, so frames handed out can still be written to in place
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, writable ? PAGE_READWRITE : PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        return false;
+    }
+
+    data = static_cast<uint8_t*>(MapViewOfFile(mappingHandle, writable ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, size));
+    return data != nullptr;
+}
+
+void MappedFile::Unmap() {
+    if (data) {
+        UnmapViewOfFile(data);
+        data = nullptr;
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+        mappingHandle = nullptr;
+    }
+}
+
+void MappedFile::Close() {
+    Unmap();
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+    }
+    size = 0;
+}
+
+#else
+
+bool MappedFile::OpenRead(const std::string& path) {
+    Close();
+
+    fileDescriptor = open(path.c_str(), O_RDONLY);
+    struct stat status;
+    if (fileDescriptor < 0 || fstat(fileDescriptor, &status) != 0 || status.st_size <= 0) {
+        Close();
+        return false;
+    }
+
+    size = static_cast<size_t>(status.st_size);
+    writable = false;
+    if (!Map()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::OpenWrite(const std::string& path, size_t initialSize) {
+    Close();
+
+    fileDescriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0) {
+        return false;
+    }
+
+    writable = true;
+    if (!Resize(initialSize)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::Resize(size_t newSize) {
+    if (!writable || fileDescriptor < 0) {
+        return false;
+    }
+
+    // ftruncate alone leaves the new part sparse, and a disk that fills up is then only noticed
+    // as SIGBUS on the first write to it. Reserving the blocks fails here instead, with the old
+    // mapping still in place.
+    if (newSize > size) {
+        int result = EOPNOTSUPP;
+#ifndef __APPLE__
+        result = posix_fallocate(fileDescriptor, static_cast<off_t>(size), static_cast<off_t>(newSize - size));
+#endif
+        if (result == EOPNOTSUPP || result == EINVAL) {
+            // Not supported by the file system, sparse it is
+            result = ftruncate(fileDescriptor, static_cast<off_t>(newSize)) == 0 ? 0 : errno;
+        }
+        if (result != 0) {
+            return false;
+        }
+    }
+    else if (ftruncate(fileDescriptor, static_cast<off_t>(newSize)) != 0) {
+        return false;
+    }
+
+    Unmap();
+    size = newSize;
+    return newSize == 0 || Map();
+}
+
+bool MappedFile::Map() {
+    // Private (copy-on-write) mappings for reading, so frames handed out can still be written to in place
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<uint8_t*>(mapping);
+    return true;
+}
+
+void MappedFile::Unmap() {
+    if (data) {
+        munmap(data, size);
+        data = nullptr;
+    }
+}
+
+void MappedFile::Close() {
+    Unmap();
+    if (fileDescriptor >= 0) {
+        close(fileDescriptor);
+        fileDescriptor = -1;
+    }
+    size = 0;
+}
+
+#endif
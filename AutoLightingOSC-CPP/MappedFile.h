@@ -0,0 +1,44 @@
+// MappedFile.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A whole file mapped into memory. Read mode maps it copy-on-write: the pages can be written,
+// but nothing reaches the file. Write mode maps it shared and changes its size with Resize.
+class MappedFile {
+private:
+    uint8_t* data;
+    size_t size;
+    bool writable;
+#ifdef _WIN32
+    void* fileHandle;    // HANDLE
+    void* mappingHandle; // HANDLE
+#else
+    int fileDescriptor;
+#endif
+
+    bool Map();
+    void Unmap();
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails for a missing or empty file
+    bool OpenRead(const std::string& path);
+    // Creates the file, or empties an existing one, and maps initialSize bytes of zeros
+    bool OpenWrite(const std::string& path, size_t initialSize);
+    // Write mode: sets the file size and maps all of it again, the data pointer changes. Growing
+    // reserves the space on disk, and a failure (a full disk) keeps the old size and mapping.
+    bool Resize(size_t newSize);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+};
@@ -23,31 +23,35 @@
 
 #include "OscManager.h"
 #include <iostream>
-#include <iomanip>
-#include <sstream>
-
-#define OSC_BUFFER_SIZE 1024
+#include <cmath>
+#include <cstring>
+#include <algorithm>
 
 OscManager::OscManager(const std::string& ipAddress, int port)
-    : ipAddress(ipAddress), port(port), oscRate(0),
-    rParameter("AL_Red"), gParameter("AL_Green"), bParameter("AL_Blue"),
-    lastMessageTime(std::chrono::steady_clock::now()) {
+    : ipAddress(ipAddress), port(port), oscRate(0), useBundles(false), maxPacketSize(1472),
+    builtParameterCount(ColorParameterCount),
+    deadBandEnabled(false), deadBandThreshold(0.0f), keepaliveInterval(1000),
+    receiverPrecisionEnabled(false),
+    sentPackets(0), sentMessages(0), suppressedMessages(0),
+    queuedSamples(0), droppedSamples(0), coalescedSamples(0),
+    lastMessageTime(std::chrono::steady_clock::now()),
+    asyncEnabled(false), senderRunning(false) {
+    RegisterParameter("AL_Red");
+    RegisterParameter("AL_Green");
+    RegisterParameter("AL_Blue");
+
     Initialize();
+    BuildDestinations();
 }
 
 OscManager::~OscManager() {
-    // Socket will be automatically cleaned up by unique_ptr
+    SetAsync(false);
+    // Socket will be automatically cleaned up by the transport
 }
 
 void OscManager::Initialize() {
-    try {
-        socket = std::make_unique<UdpTransmitSocket>(
-            IpEndpointName(ipAddress.c_str(), port)
-        );
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Error initializing OSC sender: " << e.what() << std::endl;
-        socket.reset();
+    if (!transport.EnsureOpen()) {
+        std::cerr << "Error initializing OSC sender" << std::endl;
     }
 }
 
@@ -56,65 +60,465 @@ void OscManager::SetOscRate(int rate) {
 }
 
 void OscManager::SetOscPort(int newPort) {
+    std::lock_guard<std::mutex> lock(sendMutex);
     if (port != newPort) {
         port = newPort;
-        // Reinitialize with new port
-        socket.reset();
-        Initialize();
+        BuildDestinations();
+    }
+}
+
+void OscManager::BuildDestinations() {
+    transport.ClearDestinations();
+    transport.AddDestination(ipAddress, port);
+    for (const OscDestination& destination : extraDestinations) {
+        transport.AddDestination(destination.address, destination.port);
+    }
+
+    BuildPackets(builtParameterCount);
+}
+
+std::string OscManager::GetParameterName(size_t destination, size_t parameter) const {
+    // Extra destinations only rename the colour parameters
+    if (destination > 0) {
+        const OscDestination& names = extraDestinations[destination - 1];
+        switch (parameter) {
+        case RedParameter: return names.rParameter;
+        case GreenParameter: return names.gParameter;
+        case BlueParameter: return names.bParameter;
+        }
+    }
+    return parameters[parameter].name;
+}
+
+void OscManager::BuildPackets(size_t parameterCount) {
+    builtParameterCount = parameterCount;
+    size_t destinationCount = extraDestinations.size() + 1;
+
+    std::vector<std::vector<std::string>> addresses(destinationCount);
+    for (size_t destination = 0; destination < destinationCount; destination++) {
+        for (size_t i = 0; i < parameterCount; i++) {
+            addresses[destination].push_back("/avatar/parameters/" + GetParameterName(destination, i));
+        }
+    }
+
+    // Destinations name the colour parameters differently, but they all have to put the same
+    // parameters in the same bundle: a change resends the whole bundle, to every destination.
+    // So the split makes room for the longest name of every parameter.
+    std::vector<size_t> messageBundles;
+    if (useBundles) {
+        std::vector<size_t> elementSizes(parameterCount, 0);
+        for (size_t destination = 0; destination < destinationCount; destination++) {
+            for (size_t i = 0; i < parameterCount; i++) {
+                elementSizes[i] = std::max(elementSizes[i], OscPacketTemplate::GetBundleElementSize(addresses[destination][i]));
+            }
+        }
+        messageBundles = OscPacketTemplate::SplitBundles(elementSizes, maxPacketSize);
+    }
+
+    destinationPackets.clear();
+    size_t packetCount = 0;
+    for (size_t destination = 0; destination < destinationCount; destination++) {
+        OscPacketTemplate packets;
+        if (useBundles) {
+            packets.BuildBundles(addresses[destination], messageBundles);
+        }
+        else {
+            packets.Build(addresses[destination], false);
+        }
+        packetCount += packets.GetPacketCount();
+        destinationPackets.push_back(std::move(packets));
+    }
+    datagrams.reserve(packetCount);
+
+    // New addresses have never been sent
+    ResetParameterStates();
+}
+
+void OscManager::ResetParameterStates() {
+    for (Parameter& parameter : parameters) {
+        parameter.state = ParameterState();
     }
 }
 
 void OscManager::SetParameters(const std::string& r, const std::string& g, const std::string& b) {
-    rParameter = r;
-    gParameter = g;
-    bParameter = b;
+    std::lock_guard<std::mutex> lock(sendMutex);
+    if (r == parameters[RedParameter].name && g == parameters[GreenParameter].name &&
+        b == parameters[BlueParameter].name) {
+        return;
+    }
+
+    parameters[RedParameter].name = r;
+    parameters[GreenParameter].name = g;
+    parameters[BlueParameter].name = b;
+    BuildPackets(builtParameterCount);
+}
+
+int OscManager::RegisterParameter(const std::string& name, int receiverBits) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    for (size_t i = 0; i < parameters.size(); i++) {
+        if (parameters[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+
+    // Packets only cover the parameters being sent, so they are rebuilt once values
+    // for the new one arrive
+    Parameter parameter;
+    parameter.name = name;
+    parameter.receiverBits = receiverBits;
+    parameters.push_back(parameter);
+    return static_cast<int>(parameters.size() - 1);
+}
+
+size_t OscManager::GetParameterCount() {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    return parameters.size();
+}
+
+void OscManager::SetExtraDestinations(const std::vector<OscDestination>& destinations) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    if (destinations == extraDestinations) {
+        return;
+    }
+
+    extraDestinations = destinations;
+    BuildDestinations();
+}
+
+void OscManager::SetUseBundles(bool enabled) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    if (useBundles != enabled) {
+        useBundles = enabled;
+        BuildPackets(builtParameterCount);
+    }
+}
+
+void OscManager::SetMtu(int mtu) {
+    // IPv4 and UDP headers, what is left is the payload
+    const int headerSize = 20 + 8;
+    size_t newMaxPacketSize = static_cast<size_t>(std::max(mtu - headerSize, 64));
+
+    std::lock_guard<std::mutex> lock(sendMutex);
+    if (maxPacketSize != newMaxPacketSize) {
+        maxPacketSize = newMaxPacketSize;
+        BuildPackets(builtParameterCount);
+    }
+}
+
+void OscManager::SetQuantization(int divisions, RoundingMode roundingMode) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    quantizer.SetDivisions(divisions);
+    quantizer.SetRoundingMode(roundingMode);
+}
+
+void OscManager::SetDeadBand(bool enabled, float threshold, int keepaliveMs) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    deadBandEnabled = enabled;
+    deadBandThreshold = threshold < 0.0f ? 0.0f : threshold;
+    keepaliveInterval = std::chrono::milliseconds(keepaliveMs > 0 ? keepaliveMs : 0);
+}
+
+void OscManager::SetReceiverPrecision(bool enabled, int rBits, int gBits, int bBits) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    receiverPrecisionEnabled = enabled;
+    parameters[RedParameter].receiverBits = rBits;
+    parameters[GreenParameter].receiverBits = gBits;
+    parameters[BlueParameter].receiverBits = bBits;
+
+    // Buckets of the old bit depth no longer compare
+    for (Parameter& parameter : parameters) {
+        parameter.state.lastBucket = GetReceiverBucket(parameter.state.lastValue, parameter.receiverBits);
+    }
+}
+
+void OscManager::ApplySettings(const UserSettings& settings) {
+    RoundingMode roundingMode = RoundingMode::NearestEven;
+    if (!ValueQuantizer::ParseRoundingMode(settings.oscRoundingMode, roundingMode)) {
+        std::cerr << "Unknown oscRoundingMode \"" << settings.oscRoundingMode << "\", using nearest" << std::endl;
+    }
+
+    SetOscPort(settings.oscPort);
+    SetParameters(settings.oscRParameter, settings.oscGParameter, settings.oscBParameter);
+    SetUseBundles(settings.oscUseBundles);
+    SetMtu(settings.oscMtu);
+    SetQuantization(settings.oscQuantization, roundingMode);
+    SetDeadBand(settings.oscDeadBand, settings.oscDeadBandThreshold, settings.oscKeepaliveMs);
+    SetReceiverPrecision(settings.oscReceiverPrecision,
+        settings.oscRPrecisionBits, settings.oscGPrecisionBits, settings.oscBPrecisionBits);
+    SetExtraDestinations(settings.oscExtraDestinations);
+    SetOscRate(settings.oscRate);
+}
+
+int OscManager::GetReceiverBucket(float value, int bits) {
+    // Signed [-1,1] range with 2^(bits-1) - 1 steps each side of zero, so 8 bits
+    // gives the 255 values a network-synced VRChat float can hold
+    if (bits < 2) bits = 2;
+    if (bits > 24) bits = 24;
+    const int steps = (1 << (bits - 1)) - 1;
+
+    if (value < -1.0f) value = -1.0f;
+    if (value > 1.0f) value = 1.0f;
+    return static_cast<int>(std::lround(value * static_cast<float>(steps)));
+}
+
+bool OscManager::ShouldSend(size_t parameter, float value, std::chrono::steady_clock::time_point now) const {
+    const ParameterState& state = parameters[parameter].state;
+    if ((!deadBandEnabled && !receiverPrecisionEnabled) || !state.hasSent) {
+        return true;
+    }
+
+    // Keepalive refresh, 0 disables it
+    if (keepaliveInterval.count() > 0 && now - state.lastSendTime >= keepaliveInterval) {
+        return true;
+    }
+
+    if (deadBandEnabled && std::fabs(value - state.lastValue) <= deadBandThreshold) {
+        return false;
+    }
+
+    if (receiverPrecisionEnabled && GetReceiverBucket(value, parameters[parameter].receiverBits) == state.lastBucket) {
+        return false;
+    }
+
+    return true;
+}
+
+void OscManager::SetAsync(bool enabled) {
+    if (enabled == senderThread.joinable()) {
+        return;
+    }
+
+    if (enabled) {
+        {
+            std::lock_guard<std::mutex> wakeLock(wakeMutex);
+            senderRunning = true;
+        }
+        senderThread = std::thread(&OscManager::SenderLoop, this);
+        asyncEnabled = true;
+    }
+    else {
+        asyncEnabled = false;
+        {
+            std::lock_guard<std::mutex> wakeLock(wakeMutex);
+            senderRunning = false;
+        }
+        wakeCondition.notify_one();
+        senderThread.join();
+
+        // Do not send stale values if async mode is turned on again
+        ValueChunk chunk;
+        while (queue.TryPop(chunk)) {}
+    }
+}
+
+void OscManager::SenderLoop() {
+    std::vector<float> latestValues;
+    size_t latestCount = 0;
+    bool hasSample = false;
+    auto nextSend = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> wakeLock(wakeMutex);
+    while (senderRunning) {
+        // Fixed rate that keeps its phase, but skips ahead instead of bursting after a stall
+        int rate = oscRate;
+        if (rate < 1) rate = 1;
+        nextSend += std::chrono::microseconds(1000000 / rate);
+        auto now = std::chrono::steady_clock::now();
+        if (nextSend < now) {
+            nextSend = now;
+        }
+
+        if (wakeCondition.wait_until(wakeLock, nextSend, [this] { return !senderRunning; })) {
+            break;
+        }
+        wakeLock.unlock();
+
+        // Only the newest value of each parameter matters, older calls are counted as coalesced
+        ValueChunk chunk;
+        uint64_t drained = 0;
+        while (queue.TryPop(chunk)) {
+            size_t end = static_cast<size_t>(chunk.first) + chunk.count;
+            if (latestValues.size() < end) {
+                latestValues.resize(end);
+            }
+            std::memcpy(&latestValues[chunk.first], chunk.values, chunk.count * sizeof(float));
+            latestCount = chunk.sampleCount;
+
+            if (chunk.last) {
+                drained++;
+            }
+        }
+        if (drained > 0) {
+            hasSample = true;
+            coalescedSamples += drained - 1;
+        }
+
+        // Like the synchronous timer, resend the last values when nothing new arrived
+        if (hasSample) {
+            std::lock_guard<std::mutex> lock(sendMutex);
+            Transmit(latestValues.data(), std::min(latestCount, latestValues.size()));
+        }
+
+        wakeLock.lock();
+    }
+}
+
+void OscManager::SendValues(const float* values, size_t count) {
+    if (asyncEnabled) {
+        if (count == 0) {
+            return;
+        }
+        count = std::min<size_t>(count, UINT16_MAX);
+
+        // Split into queue entries, all of the call or nothing after the first full one
+        bool queued = true;
+        for (size_t first = 0; first < count; first += ChunkValueCount) {
+            ValueChunk chunk;
+            chunk.first = static_cast<uint16_t>(first);
+            chunk.count = static_cast<uint16_t>(std::min(ChunkValueCount, count - first));
+            chunk.sampleCount = static_cast<uint16_t>(count);
+            chunk.last = first + chunk.count == count;
+            std::memcpy(chunk.values, values + first, chunk.count * sizeof(float));
+
+            if (!queue.TryPush(chunk)) {
+                queued = false;
+                break;
+            }
+        }
+
+        if (queued) {
+            queuedSamples++;
+        }
+        else {
+            droppedSamples++;
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(sendMutex);
+    Transmit(values, count);
 }
 
 void OscManager::SendColorValues(float r, float g, float b) {
-    if (!socket) {
-        Initialize();
-        if (!socket) return;
+    const float values[ColorParameterCount] = { r, g, b };
+    SendValues(values, ColorParameterCount);
+}
+
+OscManager::Stats OscManager::GetStats() const {
+    Stats stats;
+    stats.sentPackets = sentPackets;
+    stats.sentMessages = sentMessages;
+    stats.suppressedMessages = suppressedMessages;
+    stats.queuedSamples = queuedSamples;
+    stats.droppedSamples = droppedSamples;
+    stats.coalescedSamples = coalescedSamples;
+    stats.queueDepth = queue.GetSize();
+    return stats;
+}
+
+size_t OscManager::GetDestinationCount() {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    return transport.GetDestinationCount();
+}
+
+UdpTransport::DestinationStats OscManager::GetDestinationStats(size_t destination) {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    if (destination >= transport.GetDestinationCount()) {
+        return UdpTransport::DestinationStats();
     }
+    return transport.GetDestinationStats(destination);
+}
 
-    try {
-        // Map values from [0,1] to [-1,1] for OSC
-        float rMapped = r * 2.0f - 1.0f;
-        float gMapped = g * 2.0f - 1.0f;
-        float bMapped = b * 2.0f - 1.0f;
+UdpTransport::Stats OscManager::GetTransportStats() {
+    std::lock_guard<std::mutex> lock(sendMutex);
+    return transport.GetStats();
+}
 
-        // Set precision to 3 decimal places
-        auto capToThreeDecimals = [](float value) {
-            std::ostringstream out;
-            out << std::fixed << std::setprecision(3) << value;
-            return std::stof(out.str());
-        };
+void OscManager::Transmit(const float* values, size_t count) {
+    // After a fatal socket error this retries with backoff, not on every send
+    if (!transport.EnsureOpen()) {
+        return;
+    }
 
-        rMapped = capToThreeDecimals(rMapped);
-        gMapped = capToThreeDecimals(gMapped);
-        bMapped = capToThreeDecimals(bMapped);
+    // Values past the table have no name to send them under
+    count = std::min(count, parameters.size());
+    if (count != builtParameterCount) {
+        BuildPackets(count);
+    }
 
-        // Create and send OSC messages
-        char buffer[OSC_BUFFER_SIZE];
-        osc::OutboundPacketStream p(buffer, OSC_BUFFER_SIZE);
+    if (mappedValues.size() < count) {
+        mappedValues.resize(count);
+        sendParameter.resize(count);
+    }
 
-        // Use the configurable parameter names
-        std::string rPath = "/avatar/parameters/" + rParameter;
-        std::string gPath = "/avatar/parameters/" + gParameter;
-        std::string bPath = "/avatar/parameters/" + bParameter;
+    auto now = std::chrono::steady_clock::now();
+    bool sendAny = false;
+    for (size_t i = 0; i < count; i++) {
+        // Map values from [0,1] to [-1,1] for OSC, then round to the configured step
+        // (3 decimal places by default)
+        mappedValues[i] = quantizer.Quantize(values[i] * 2.0f - 1.0f);
+        sendParameter[i] = ShouldSend(i, mappedValues[i], now);
+        sendAny = sendAny || sendParameter[i];
+    }
+    if (!sendAny) {
+        suppressedMessages += count;
+        return;
+    }
 
-        p << osc::BeginMessage(rPath.c_str()) << rMapped << osc::EndMessage;
-        socket->Send(p.Data(), p.Size());
-        p.Clear();
+    // In bundle mode the parameters of a bundle are applied together, so any change in
+    // it sends all of them. Every destination splits the parameters into the same bundles.
+    const OscPacketTemplate& layout = destinationPackets[0];
+    if (useBundles) {
+        sendPacket.assign(layout.GetPacketCount(), 0);
+        for (size_t i = 0; i < count; i++) {
+            if (sendParameter[i]) {
+                sendPacket[layout.GetMessagePacket(i)] = 1;
+            }
+        }
+        for (size_t i = 0; i < count; i++) {
+            sendParameter[i] = sendPacket[layout.GetMessagePacket(i)];
+        }
+    }
 
-        p << osc::BeginMessage(gPath.c_str()) << gMapped << osc::EndMessage;
-        socket->Send(p.Data(), p.Size());
-        p.Clear();
+    size_t sendCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!sendParameter[i]) {
+            suppressedMessages++;
+            continue;
+        }
 
-        p << osc::BeginMessage(bPath.c_str()) << bMapped << osc::EndMessage;
-        socket->Send(p.Data(), p.Size());
+        ParameterState& state = parameters[i].state;
+        state.hasSent = true;
+        state.lastValue = mappedValues[i];
+        state.lastBucket = GetReceiverBucket(mappedValues[i], parameters[i].receiverBits);
+        state.lastSendTime = now;
+        sendCount++;
     }
-    catch (const std::exception& e) {
-        std::cerr << "Error sending OSC message: " << e.what() << std::endl;
-        socket.reset(); // Force reinitialization on next attempt
+
+    // Patch the values into every destination's pre-encoded packets and send them as one
+    // batch. Each bundle has a shared (immediate) timetag and is applied atomically.
+    datagrams.clear();
+    for (size_t destination = 0; destination < destinationPackets.size(); destination++) {
+        OscPacketTemplate& packets = destinationPackets[destination];
+
+        for (size_t i = 0; i < count; i++) {
+            if (!sendParameter[i]) continue;
+
+            packets.SetValue(i, mappedValues[i]);
+            if (!useBundles) {
+                datagrams.push_back({ destination, packets.GetPacketData(i), packets.GetPacketSize(i) });
+            }
+        }
+
+        if (useBundles) {
+            for (size_t packet = 0; packet < packets.GetPacketCount(); packet++) {
+                if (sendPacket[packet]) {
+                    datagrams.push_back({ destination, packets.GetPacketData(packet), packets.GetPacketSize(packet) });
+                }
+            }
+        }
     }
-}
\ No newline at end of file
+
+    sentPackets += transport.Send(datagrams.data(), datagrams.size());
+    sentMessages += sendCount * destinationPackets.size();
+}
@@ -4,22 +4,130 @@
 #include <string>
 #include <memory>
 #include <chrono>
-#include <osc/OscOutboundPacketStream.h>
-#include <ip/UdpSocket.h>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+#include "UdpTransport.h"
+#include "UserSettings.h"
+#include "OscPacketTemplate.h"
+#include "ValueQuantizer.h"
+#include "SpscRing.h"
 
 class OscManager {
+public:
+    // IDs of the colour parameters, always registered first
+    static const int RedParameter = 0;
+    static const int GreenParameter = 1;
+    static const int BlueParameter = 2;
+
+    struct Stats {
+        uint64_t sentPackets = 0;
+        uint64_t sentMessages = 0;       // Values handed to the transport, counted per destination
+        uint64_t suppressedMessages = 0; // Parameter updates skipped by the dead-band or receiver precision
+        uint64_t queuedSamples = 0;      // Async mode: SendValues calls handed to the sender thread
+        uint64_t droppedSamples = 0;     // Async mode: calls (partly) lost because the queue was full
+        uint64_t coalescedSamples = 0;   // Async mode: calls replaced by a newer one before being sent
+        size_t queueDepth = 0;
+    };
+
 private:
+    static const int ColorParameterCount = 3;
+    // Values per queue entry, a SendValues call takes as many entries as it needs
+    static constexpr size_t ChunkValueCount = 12;
+    // Colour only, at the 60 Hz smoothing rate this holds 17 s of updates at the lowest OSC rate
+    static constexpr size_t QueueCapacity = 1024;
+
+    // Part of one SendValues call, in async mode
+    struct ValueChunk {
+        uint16_t first;       // ID of values[0]
+        uint16_t count;       // Values used in this chunk
+        uint16_t sampleCount; // Values in the whole call
+        bool last;            // Final chunk of the call
+        float values[ChunkValueCount];
+    };
+
+    // What was last sent for a parameter, for change suppression
+    struct ParameterState {
+        bool hasSent = false;
+        float lastValue = 0.0f;
+        int lastBucket = 0; // Receiver-side value of lastValue, see GetReceiverBucket
+        std::chrono::steady_clock::time_point lastSendTime;
+    };
+
+    struct Parameter {
+        std::string name;
+        int receiverBits = 8;
+        ParameterState state;
+    };
+
     std::string ipAddress;
     int port;
-    int oscRate;
-    std::string rParameter;
-    std::string gParameter;
-    std::string bParameter;
+    std::atomic<int> oscRate;
+    bool useBundles;
+    size_t maxPacketSize; // UDP payload a bundle may fill
+
+    // Registered parameters, indexed by their ID
+    std::vector<Parameter> parameters;
 
-    std::unique_ptr<UdpTransmitSocket> socket;
+    // ipAddress:port is destination 0, these follow it with their own colour parameter names
+    std::vector<OscDestination> extraDestinations;
+    // Encoded packets for each destination, covering parameters [0, builtParameterCount).
+    // Rebuilt when a name or the number of values sent changes.
+    std::vector<OscPacketTemplate> destinationPackets;
+    size_t builtParameterCount;
+
+    // Scratch for Transmit, only grown, so steady-state sends do not allocate
+    std::vector<float> mappedValues;
+    std::vector<char> sendParameter;
+    std::vector<char> sendPacket;
+    std::vector<UdpTransport::Datagram> datagrams;
+
+    ValueQuantizer quantizer;
+
+    // Dead-band: skip parameters that moved by no more than the threshold since they were
+    // last sent, but still refresh each one every keepaliveInterval
+    bool deadBandEnabled;
+    float deadBandThreshold;
+    std::chrono::milliseconds keepaliveInterval;
+    // Receiver precision: skip parameters whose value would land in the same step as the
+    // last sent one once the receiver quantises it to the parameter's receiverBits
+    bool receiverPrecisionEnabled;
+
+    std::atomic<uint64_t> sentPackets;
+    std::atomic<uint64_t> sentMessages;
+    std::atomic<uint64_t> suppressedMessages;
+    std::atomic<uint64_t> queuedSamples;
+    std::atomic<uint64_t> droppedSamples;
+    std::atomic<uint64_t> coalescedSamples;
+
+    UdpTransport transport;
     std::chrono::steady_clock::time_point lastMessageTime;
 
+    // Held while sending and while changing anything a send reads, so the setters are
+    // safe to call from the UI thread while the sender thread is running
+    std::mutex sendMutex;
+
+    // Async mode: SendValues only queues the values, senderThread sends the newest ones
+    // at oscRate. The UI thread is the only producer and senderThread the only consumer.
+    SpscRing<ValueChunk, QueueCapacity> queue;
+    std::atomic<bool> asyncEnabled;
+    std::thread senderThread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    bool senderRunning; // Guarded by wakeMutex
+
     void Initialize();
+    void BuildDestinations(); // Registers every destination with the transport, then BuildPackets
+    void BuildPackets(size_t parameterCount);
+    std::string GetParameterName(size_t destination, size_t parameter) const;
+    void ResetParameterStates();
+    bool ShouldSend(size_t parameter, float value, std::chrono::steady_clock::time_point now) const;
+    static int GetReceiverBucket(float value, int bits);
+    void Transmit(const float* values, size_t count); // Caller holds sendMutex
+    void SenderLoop();
 
 public:
     OscManager(const std::string& ipAddress = "127.0.0.1", int port = 9000);
@@ -27,6 +135,42 @@ public:
 
     void SetOscRate(int rate);
     void SetOscPort(int port);
+    // Names of the colour parameters
     void SetParameters(const std::string& r, const std::string& g, const std::string& b);
+    // Adds a parameter to the table and returns its ID, the next free index. IDs never change,
+    // registering a name again returns the existing one.
+    int RegisterParameter(const std::string& name, int receiverBits = 8);
+    size_t GetParameterCount();
+    // Also send every value to these receivers. All destinations share one socket and go
+    // out as one batch per send, and an unreachable one does not affect the others.
+    void SetExtraDestinations(const std::vector<OscDestination>& destinations);
+    // Send all parameters as #bundles, so receivers apply them together.
+    // Off sends one message per parameter, for receivers that do not handle bundles.
+    void SetUseBundles(bool enabled);
+    // Largest datagram (including IP and UDP headers) a bundle may fill
+    void SetMtu(int mtu);
+    // Step (1 / divisions) and rounding applied to the values before sending
+    void SetQuantization(int divisions, RoundingMode roundingMode);
+    // Only send parameters whose (quantised) value changed by more than threshold,
+    // plus a refresh of every parameter each keepaliveMs so late receivers converge.
+    // In bundle mode a change resends the whole bundle the parameter is in.
+    void SetDeadBand(bool enabled, float threshold, int keepaliveMs);
+    // Only send parameters whose value changes what a receiver syncing it at the given
+    // bit depth sees (VRChat syncs float parameters at 8 bits). Shares the dead-band keepalive.
+    void SetReceiverPrecision(bool enabled, int rBits, int gBits, int bBits);
+    // Applies every OSC option of the settings: port, parameter names, destinations, rate,
+    // bundles, MTU, quantization, dead-band and receiver precision
+    void ApplySettings(const UserSettings& settings);
+    // Send from a dedicated thread on its own schedule, so a slow send never stalls the caller.
+    // Must be called from the thread that calls SendValues.
+    void SetAsync(bool enabled);
+    // Sends values[i] (0 to 1) to parameter ID i for every i below count, in as few packets as
+    // the MTU allows. In async mode they are queued for the sender thread without blocking.
+    void SendValues(const float* values, size_t count);
     void SendColorValues(float r, float g, float b);
-};
\ No newline at end of file
+
+    Stats GetStats() const;
+    size_t GetDestinationCount();
+    UdpTransport::DestinationStats GetDestinationStats(size_t destination);
+    UdpTransport::Stats GetTransportStats();
+};
@@ -0,0 +1,142 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// OscPacketTemplate.cpp
+
+#include "OscPacketTemplate.h"
+
+void OscPacketTemplate::AppendPadded(const char* data, size_t length) {
+    // OSC strings are null terminated and padded to a multiple of 4 bytes
+    size_t paddedLength = (length + 4) & ~static_cast<size_t>(3);
+    buffer.insert(buffer.end(), data, data + length);
+    buffer.insert(buffer.end(), paddedLength - length, '\0');
+}
+
+void OscPacketTemplate::AppendInt32(uint32_t value) {
+    buffer.push_back(static_cast<char>(value >> 24));
+    buffer.push_back(static_cast<char>(value >> 16));
+    buffer.push_back(static_cast<char>(value >> 8));
+    buffer.push_back(static_cast<char>(value));
+}
+
+void OscPacketTemplate::AppendMessage(const std::string& address) {
+    AppendPadded(address.data(), address.size());
+    AppendPadded(",f", 2);
+
+    valueOffsets.push_back(buffer.size());
+    AppendInt32(0);
+}
+
+void OscPacketTemplate::BeginBundle() {
+    packetOffsets.push_back(buffer.size());
+    AppendPadded("#bundle", 7);
+    AppendInt32(0); // Timetag 1 means "immediately"
+    AppendInt32(1);
+}
+
+size_t OscPacketTemplate::GetBundleElementSize(const std::string& address) {
+    // Size prefix, padded address, ",f" type tags and the float
+    return 4 + ((address.size() + 4) & ~static_cast<size_t>(3)) + 4 + 4;
+}
+
+std::vector<size_t> OscPacketTemplate::SplitBundles(const std::vector<size_t>& elementSizes, size_t maxPacketSize) {
+    const size_t bundleHeaderSize = 16;
+
+    std::vector<size_t> elementBundles;
+    elementBundles.reserve(elementSizes.size());
+    size_t bundle = 0;
+    size_t bundleSize = bundleHeaderSize;
+
+    for (size_t elementSize : elementSizes) {
+        // Start a new bundle if this element would not fit, unless the current one is empty
+        if (maxPacketSize > 0 && bundleSize > bundleHeaderSize && bundleSize + elementSize > maxPacketSize) {
+            bundle++;
+            bundleSize = bundleHeaderSize;
+        }
+        elementBundles.push_back(bundle);
+        bundleSize += elementSize;
+    }
+    return elementBundles;
+}
+
+void OscPacketTemplate::Build(const std::vector<std::string>& addresses, bool bundled, size_t maxPacketSize) {
+    if (bundled) {
+        std::vector<size_t> elementSizes;
+        elementSizes.reserve(addresses.size());
+        for (const std::string& address : addresses) {
+            elementSizes.push_back(GetBundleElementSize(address));
+        }
+        BuildBundles(addresses, SplitBundles(elementSizes, maxPacketSize));
+        return;
+    }
+
+    buffer.clear();
+    packetOffsets.clear();
+    packetSizes.clear();
+    valueOffsets.clear();
+    messagePackets.clear();
+
+    for (const std::string& address : addresses) {
+        size_t start = buffer.size();
+        packetOffsets.push_back(start);
+        messagePackets.push_back(packetOffsets.size() - 1);
+        AppendMessage(address);
+        packetSizes.push_back(buffer.size() - start);
+    }
+}
+
+void OscPacketTemplate::BuildBundles(const std::vector<std::string>& addresses, const std::vector<size_t>& messageBundles) {
+    buffer.clear();
+    packetOffsets.clear();
+    packetSizes.clear();
+    valueOffsets.clear();
+    messagePackets.clear();
+
+    for (size_t i = 0; i < addresses.size(); i++) {
+        // Close the current bundle when the message goes into the next one
+        bool bundleOpen = packetOffsets.size() > packetSizes.size();
+        if (bundleOpen && messageBundles[i] != packetOffsets.size() - 1) {
+            packetSizes.push_back(buffer.size() - packetOffsets.back());
+            bundleOpen = false;
+        }
+        if (!bundleOpen) {
+            BeginBundle();
+        }
+
+        // Every element is prefixed with its size
+        size_t sizeOffset = buffer.size();
+        AppendInt32(0);
+        AppendMessage(addresses[i]);
+        messagePackets.push_back(packetOffsets.size() - 1);
+
+        uint32_t messageSize = static_cast<uint32_t>(buffer.size() - sizeOffset - 4);
+        buffer[sizeOffset + 0] = static_cast<char>(messageSize >> 24);
+        buffer[sizeOffset + 1] = static_cast<char>(messageSize >> 16);
+        buffer[sizeOffset + 2] = static_cast<char>(messageSize >> 8);
+        buffer[sizeOffset + 3] = static_cast<char>(messageSize);
+    }
+
+    // An empty address list still gets one (empty) bundle
+    if (packetOffsets.empty()) {
+        BeginBundle();
+    }
+    packetSizes.push_back(buffer.size() - packetOffsets.back());
+}
@@ -0,0 +1,60 @@
+// OscPacketTemplate.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Fully encoded OSC packets for a fixed set of single-float messages.
+// The addresses are encoded once in Build, after which sending only patches the big-endian
+// float arguments in place: no strings, no serialisation and no allocation per send.
+// The messages are either separate packets or #bundles with an immediate timetag, packed
+// greedily in order so each bundle stays within the maximum packet size.
+class OscPacketTemplate {
+private:
+    std::vector<char> buffer;          // Every packet, back to back
+    std::vector<size_t> packetOffsets; // Start of each packet in buffer
+    std::vector<size_t> packetSizes;
+    std::vector<size_t> valueOffsets;  // Position of each message's float argument in buffer
+    std::vector<size_t> messagePackets; // Packet each message is in
+
+    void AppendPadded(const char* data, size_t length);
+    void AppendInt32(uint32_t value);
+    void AppendMessage(const std::string& address);
+    void BeginBundle();
+
+public:
+    // Encodes one message per address, in as few bundles as fit in maxPacketSize bytes when
+    // bundled is set (0 puts them all in one). A message too large on its own gets its own bundle.
+    void Build(const std::vector<std::string>& addresses, bool bundled, size_t maxPacketSize = 0);
+    // Encodes one message per address into bundles, message i into bundle messageBundles[i].
+    // Bundle numbers start at 0 and never decrease, as SplitBundles returns them.
+    void BuildBundles(const std::vector<std::string>& addresses, const std::vector<size_t>& messageBundles);
+
+    // Bytes a message to address takes in a bundle, its size prefix included
+    static size_t GetBundleElementSize(const std::string& address);
+    // Bundle of every element when they are packed greedily, in order, into bundles of at most
+    // maxPacketSize bytes (0 for a single bundle). An element too large on its own gets its own.
+    static std::vector<size_t> SplitBundles(const std::vector<size_t>& elementSizes, size_t maxPacketSize);
+
+    size_t GetMessageCount() const { return valueOffsets.size(); }
+    size_t GetPacketCount() const { return packetOffsets.size(); }
+    const char* GetPacketData(size_t packet) const { return buffer.data() + packetOffsets[packet]; }
+    size_t GetPacketSize(size_t packet) const { return packetSizes[packet]; }
+    size_t GetMessagePacket(size_t message) const { return messagePackets[message]; }
+
+    // Writes the float argument of a message
+    void SetValue(size_t message, float value) {
+        uint32_t bits;
+        static_assert(sizeof(bits) == sizeof(value), "OSC floats are 32-bit");
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        char* out = buffer.data() + valueOffsets[message];
+        out[0] = static_cast<char>(bits >> 24);
+        out[1] = static_cast<char>(bits >> 16);
+        out[2] = static_cast<char>(bits >> 8);
+        out[3] = static_cast<char>(bits);
+    }
+};
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// PipelineThread.cpp
+
+#include "PipelineThread.h"
+#include "FrameRecording.h"
+#include "OscManager.h"
+#include <algorithm>
+#include <chrono>
+
+constexpr std::chrono::microseconds PipelineThread::SmoothingInterval;
+constexpr std::chrono::milliseconds PipelineThread::StatsInterval;
+
+PipelineThread::PipelineThread(OscManager& oscManager)
+    : oscManager(oscManager), colorProcessor(settings), colorPipeline(settings, colorProcessor, oscManager),
+    source(nullptr), recorder(nullptr), frameCount(0), asyncEnabled(false), paced(true), running(false), sourceLost(false) {
+    // Periods are set from the settings when the thread starts
+    captureTask = scheduler.AddTask("Capture", std::chrono::milliseconds(200), [this](DeadlineScheduler::Clock::time_point) {
+        CaptureStep();
+    });
+    smoothingTask = scheduler.AddTask("Smoothing", SmoothingInterval, [this](DeadlineScheduler::Clock::time_point now) {
+        SmoothingStep(now);
+    });
+    oscTask = scheduler.AddTask("OSC", std::chrono::milliseconds(200), [this](DeadlineScheduler::Clock::time_point) {
+        colorPipeline.SendOsc();
+    });
+}
+
+PipelineThread::~PipelineThread() {
+    Stop();
+}
+
+void PipelineThread::Start(const UserSettings& newSettings, CaptureFunction newCapture) {
+    StartThread(newSettings, std::move(newCapture), nullptr);
+}
+
+void PipelineThread::Start(const UserSettings& newSettings, IFrameSource& newSource) {
+    StartThread(newSettings, [&newSource](CapturedFrame& frame) {
+        newSource.ReleaseFrame(frame);
+        return newSource.AcquireFrame(frame);
+    }, &newSource);
+}
+
+void PipelineThread::StartThread(const UserSettings& newSettings, CaptureFunction newCapture, IFrameSource* newSource) {
+    Stop();
+
+    // Settings handed over while stopped are older than these
+    settingsBuffer.Update();
+    settings = newSettings;
+    capture = std::move(newCapture);
+    source = newSource;
+    paced = !source || source->IsPaced();
+
+    sourceLost = false;
+    running = true;
+    thread = std::thread(&PipelineThread::ThreadLoop, this);
+}
+
+void PipelineThread::Stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void PipelineThread::SetSettings(const UserSettings& newSettings) {
+    settingsBuffer.GetWriteBuffer() = newSettings;
+    settingsBuffer.Publish();
+}
+
+void PipelineThread::SetInput(const Input& newInput) {
+    inputBuffer.GetWriteBuffer() = newInput;
+    inputBuffer.Publish();
+}
+
+void PipelineThread::ThreadLoop() {
+    // SendValues is called from this thread, so async mode is switched here too
+    asyncEnabled = settings.oscAsync;
+    oscManager.SetAsync(asyncEnabled);
+    ApplyTaskRates();
+
+    auto now = DeadlineScheduler::Clock::now();
+    scheduler.Reset(now);
+    scheduler.ResetStats();
+    lastSmoothingTime = paced ? now : DeadlineScheduler::Clock::time_point();
+
+    ColorRGB publishedColor = colorPipeline.GetCurrentColor();
+    uint64_t publishedFrameCount = frameCount;
+    auto lastStatsTime = now - StatsInterval;
+    DeadlineScheduler::TaskStats captureStats, smoothingStats, oscStats;
+
+    while (running && !sourceLost) {
+        TakeUpdates();
+
+        // Sleeps until the next step is due, an unpaced source is captured from straight away
+        if (paced) {
+            scheduler.RunNext();
+        }
+        else {
+            UnpacedStep();
+        }
+
+        // Only publish when something changed, the UI keeps showing the last value
+        const ColorRGB& color = colorPipeline.GetCurrentColor();
+        now = DeadlineScheduler::Clock::now();
+        bool statsDue = now - lastStatsTime >= StatsInterval;
+        if (color != publishedColor || frameCount != publishedFrameCount || statsDue) {
+            if (statsDue) {
+                captureStats = scheduler.GetStats(captureTask);
+                smoothingStats = scheduler.GetStats(smoothingTask);
+                oscStats = scheduler.GetStats(oscTask);
+                lastStatsTime = now;
+
+                // Asked here, on the thread that captures from the source
+                if (source) {
+                    sourceDescription = source->GetDescription();
+                }
+                else {
+                    sourceDescription.clear();
+                }
+            }
+
+            Output& output = outputBuffer.GetWriteBuffer();
+            output.color = color;
+            output.frameCount = frameCount;
+            output.captureStats = captureStats;
+            output.smoothingStats = smoothingStats;
+            output.oscStats = oscStats;
+            output.sourceDescription = sourceDescription;
+            outputBuffer.Publish();
+
+            publishedColor = color;
+            publishedFrameCount = frameCount;
+        }
+    }
+
+    // Let go of the last frame, the source may be closed once the thread stopped
+    frame = CapturedFrame();
+
+    // Stop the sender thread so it does not keep resending the last colour
+    oscManager.SetAsync(false);
+    running = false;
+}
+
+void PipelineThread::TakeUpdates() {
+    if (settingsBuffer.Update()) {
+        settings = settingsBuffer.GetReadBuffer();
+        if (settings.oscAsync != asyncEnabled) {
+            asyncEnabled = settings.oscAsync;
+            oscManager.SetAsync(asyncEnabled);
+        }
+        ApplyTaskRates();
+    }
+
+    if (inputBuffer.Update()) {
+        input = inputBuffer.GetReadBuffer();
+
+        // A dragged selection is answered from the last frame right away, not at the next capture
+        if (input.liveSelection) {
+            colorPipeline.UpdateSelectionColor(input.crop);
+        }
+    }
+}
+
+void PipelineThread::ApplyTaskRates() {
+    scheduler.SetPeriod(captureTask, std::chrono::microseconds(1000000 / std::max(settings.captureFps, 1)));
+    scheduler.SetPeriod(oscTask, std::chrono::microseconds(1000000 / std::max(settings.oscRate, 1)));
+    scheduler.SetEnabled(captureTask, paced);
+    scheduler.SetEnabled(smoothingTask, paced);
+
+    // The sender thread keeps its own schedule in async mode
+    scheduler.SetEnabled(oscTask, paced && !asyncEnabled);
+}
+
+void PipelineThread::CaptureStep() {
+    CaptureResult result = capture(frame);
+    if (result == CaptureResult::SourceLost) {
+        sourceLost = true;
+    }
+    else if (result == CaptureResult::Captured) {
+        // A crop that came with the frame (a replayed recording) replaces the UI's
+        const PixelRect& frameCrop = frame.crop;
+        bool hasFrameCrop = frameCrop.right > frameCrop.left && frameCrop.bottom > frameCrop.top;
+        const PixelRect& crop = hasFrameCrop ? frameCrop : input.crop;
+
+        if (recorder && !recorder->Append(frame.bitmap, frame.timestamp, crop)) {
+            recorder = nullptr; // The file could not grow, it was closed with what it has
+        }
+
+        ProcessCapturedFrame(crop, !hasFrameCrop && input.liveSelection);
+    }
+}
+
+void PipelineThread::SmoothingStep(DeadlineScheduler::Clock::time_point now) {
+    colorPipeline.UpdateSmoothing(std::chrono::duration<float>(now - lastSmoothingTime).count());
+    lastSmoothingTime = now;
+
+    // In async mode every smoothed colour is queued, the sender thread picks the newest
+    if (asyncEnabled) {
+        colorPipeline.SendOsc();
+    }
+}
+
+void PipelineThread::UnpacedStep() {
+    uint64_t previousFrameCount = frameCount;
+    CaptureStep();
+    if (frameCount == previousFrameCount) {
+        return;
+    }
+
+    // Smoothed over the time between the frames' timestamps and sent once per frame, so the
+    // output depends on the frames alone and not on how fast they were captured
+    if (lastSmoothingTime == DeadlineScheduler::Clock::time_point()) {
+        lastSmoothingTime = frame.timestamp;
+    }
+    SmoothingStep(frame.timestamp);
+    if (!asyncEnabled) {
+        colorPipeline.SendOsc();
+    }
+}
+
+void PipelineThread::ProcessCapturedFrame(const PixelRect& crop, bool liveSelection) {
+    const Bitmap& bitmap = frame.bitmap;
+
+    // The preview is generated straight into the slot the UI will take next, never copied
+    if (input.previewWidth > 0 && input.previewHeight > 0) {
+        Preview& preview = previewBuffer.GetWriteBuffer();
+        if (previewGenerator.Generate(bitmap, input.previewWidth, input.previewHeight, preview.image)) {
+            preview.frameWidth = bitmap.width;
+            preview.frameHeight = bitmap.height;
+            previewBuffer.Publish();
+        }
+    }
+
+    colorPipeline.ProcessFrame(bitmap, crop, liveSelection);
+    frameCount++;
+}
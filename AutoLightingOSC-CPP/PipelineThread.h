@@ -0,0 +1,145 @@
+// PipelineThread.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include "ColorPipeline.h"
+#include "ColorProcessor.h"
+#include "DeadlineScheduler.h"
+#include "IFrameSource.h"
+#include "PreviewGenerator.h"
+#include "TripleBuffer.h"
+#include "UserSettings.h"
+
+class FrameRecorder;
+class OscManager;
+
+// Runs capture, colour processing, smoothing and OSC output on a dedicated thread, so a slow
+// capture never stalls the UI and UI frames never delay a capture. The three steps are tasks of
+// a DeadlineScheduler, the thread sleeps until the next one is due. Everything crosses between
+// the threads through triple buffers: the UI hands over settings and what it controls (crop,
+// preview size), the pipeline publishes the output colour and preview. Neither side ever waits.
+// All public methods are for the UI thread; the capture function runs on the pipeline thread.
+class PipelineThread {
+public:
+    // SourceLost stops the thread, see IsSourceLost
+    typedef ::CaptureResult CaptureResult;
+
+    // Fills frame with the next captured frame. It still holds the previous one, to release.
+    typedef std::function<CaptureResult(CapturedFrame& frame)> CaptureFunction;
+
+    struct Input {
+        PixelRect crop = { 0, 0, 0, 0 }; // Area of the frame to average, empty for the whole frame
+        bool liveSelection = false;      // crop is a selection being dragged, its colour follows it between captures
+        int previewWidth = 0;            // Largest preview to generate, 0 for none
+        int previewHeight = 0;
+
+        bool operator==(const Input& other) const {
+            return crop.left == other.crop.left && crop.top == other.crop.top &&
+                crop.right == other.crop.right && crop.bottom == other.crop.bottom &&
+                liveSelection == other.liveSelection &&
+                previewWidth == other.previewWidth && previewHeight == other.previewHeight;
+        }
+
+        bool operator!=(const Input& other) const {
+            return !(*this == other);
+        }
+    };
+
+    struct Output {
+        ColorRGB color;          // Smoothed colour, as sent over OSC
+        uint64_t frameCount = 0; // Frames processed since the pipeline was created
+        std::string sourceDescription; // IFrameSource::GetDescription, refreshed with the stats
+
+        // Scheduling of each step since capture started, refreshed a few times per second
+        DeadlineScheduler::TaskStats captureStats;
+        DeadlineScheduler::TaskStats smoothingStats;
+        DeadlineScheduler::TaskStats oscStats;
+    };
+
+    struct Preview {
+        Bitmap image;        // RGBA8
+        int frameWidth = 0;  // Size of the captured frame it was made from
+        int frameHeight = 0;
+    };
+
+private:
+    static constexpr std::chrono::microseconds SmoothingInterval{ 16667 }; // ~60fps (1000000/60)
+    static constexpr std::chrono::milliseconds StatsInterval{ 250 };
+
+    OscManager& oscManager;
+
+    // Only touched by the pipeline thread while it runs
+    UserSettings settings;
+    ColorProcessor colorProcessor;
+    ColorPipeline colorPipeline;
+    PreviewGenerator previewGenerator;
+    CaptureFunction capture;
+    IFrameSource* source; // Null when capturing through a CaptureFunction
+    std::string sourceDescription;
+    CapturedFrame frame;
+    Input input;
+    FrameRecorder* recorder;
+    uint64_t frameCount;
+    bool asyncEnabled;
+    bool paced; // False when the source wants its captures back to back, see IFrameSource::IsPaced
+
+    DeadlineScheduler scheduler;
+    size_t captureTask;
+    size_t smoothingTask;
+    size_t oscTask;
+    DeadlineScheduler::Clock::time_point lastSmoothingTime; // Of the last frame when unpaced, zero before it
+
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<bool> sourceLost;
+
+    TripleBuffer<UserSettings> settingsBuffer; // UI to pipeline
+    TripleBuffer<Input> inputBuffer;           // UI to pipeline
+    TripleBuffer<Output> outputBuffer;         // Pipeline to UI
+    TripleBuffer<Preview> previewBuffer;       // Pipeline to UI
+
+    void StartThread(const UserSettings& settings, CaptureFunction capture, IFrameSource* source);
+    void ThreadLoop();
+    void TakeUpdates();    // Settings and input handed over by the UI
+    void ApplyTaskRates(); // Capture and OSC periods from the settings
+    void CaptureStep();
+    void SmoothingStep(DeadlineScheduler::Clock::time_point now);
+    void UnpacedStep(); // All three steps for one frame, in the frame's own time
+    void ProcessCapturedFrame(const PixelRect& crop, bool liveSelection);
+
+public:
+    PipelineThread(OscManager& oscManager);
+    ~PipelineThread();
+
+    PipelineThread(const PipelineThread&) = delete;
+    PipelineThread& operator=(const PipelineThread&) = delete;
+
+    // Starts capturing with these settings, restarting the thread if it is running
+    void Start(const UserSettings& settings, CaptureFunction capture);
+    // Same, capturing from source. The source must be open and outlive the thread. A source that
+    // is not paced is captured from back to back, ignoring the capture rate.
+    void Start(const UserSettings& settings, IFrameSource& source);
+    // Appends every captured frame to recorder, with the crop it was averaged with, from the
+    // next Start on. Null stops recording. Only while stopped, the recorder must outlive the thread.
+    void SetRecorder(FrameRecorder* recorder) { this->recorder = recorder; }
+    // Waits for the current capture to finish, then stops the thread and async OSC output
+    void Stop();
+    bool IsRunning() const { return running; }
+    // The capture function reported the source lost and the thread has exited. Stop still has to be called.
+    bool IsSourceLost() const { return sourceLost; }
+
+    // Picked up by the pipeline before its next step
+    void SetSettings(const UserSettings& settings);
+    void SetInput(const Input& input);
+
+    // Take the newest published value, false if nothing new was published since the last call.
+    // The Get methods return the value taken by the last update.
+    bool UpdateOutput() { return outputBuffer.Update(); }
+    const Output& GetOutput() const { return outputBuffer.GetReadBuffer(); }
+    bool UpdatePreview() { return previewBuffer.Update(); }
+    const Preview& GetPreview() const { return previewBuffer.GetReadBuffer(); }
+};
@@ -0,0 +1,44 @@
+// PixelFormat.h
+#pragma once
+
+// Byte order of 4-byte pixels. Each frame source declares the format it produces.
+enum class PixelFormat {
+    BGRA8, // GDI and Windows Graphics Capture
+    RGBA8  // Spout2 / DXGI_FORMAT_R8G8B8A8
+};
+
+// Byte offset of every channel within a pixel, fixed at compile time per format
+template <PixelFormat Format>
+struct PixelLayout;
+
+template <>
+struct PixelLayout<PixelFormat::BGRA8> {
+    static const PixelFormat Format = PixelFormat::BGRA8;
+    static const int Red = 2;
+    static const int Green = 1;
+    static const int Blue = 0;
+    static const int Alpha = 3;
+};
+
+template <>
+struct PixelLayout<PixelFormat::RGBA8> {
+    static const PixelFormat Format = PixelFormat::RGBA8;
+    static const int Red = 0;
+    static const int Green = 1;
+    static const int Blue = 2;
+    static const int Alpha = 3;
+};
+
+// Calls visitor with the PixelLayout of format, so that a kernel is instantiated once per
+// format and the format is only looked at once per call instead of once per pixel.
+// Adding a format means adding a PixelLayout specialisation and a case here.
+template <typename Visitor>
+auto DispatchPixelFormat(PixelFormat format, Visitor&& visitor) {
+    switch (format) {
+    case PixelFormat::RGBA8:
+        return visitor(PixelLayout<PixelFormat::RGBA8>());
+    case PixelFormat::BGRA8:
+    default:
+        return visitor(PixelLayout<PixelFormat::BGRA8>());
+    }
+}
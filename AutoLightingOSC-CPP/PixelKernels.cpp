@@ -0,0 +1,381 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// PixelKernels.cpp
+
+#include "PixelKernels.h"
+#include <cstdio>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXELKERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PIXELKERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// MSVC allows AVX2 intrinsics anywhere, GCC/Clang need the target enabled per function
+#if defined(PIXELKERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PIXELKERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#define PIXELKERNELS_TARGET_SSE2 __attribute__((target("sse2")))
+#define PIXELKERNELS_TARGET_SSSE3 __attribute__((target("ssse3")))
+#else
+#define PIXELKERNELS_TARGET_AVX2
+#define PIXELKERNELS_TARGET_SSE2
+#define PIXELKERNELS_TARGET_SSSE3
+#endif
+
+typedef void (*SumChannelsFn)(const uint8_t*, int, int, int, ChannelSums&);
+typedef void (*ShufflePixelsFn)(const uint8_t*, const int*, int, const uint8_t[4], uint8_t*);
+
+static inline uint32_t LoadPixel(const uint8_t* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void SumChannelsScalar(const uint8_t* data, int width, int height, int stride, ChannelSums& sums) {
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* p = data + static_cast<size_t>(y) * stride;
+        const uint8_t* end = p + static_cast<size_t>(width) * 4;
+
+        for (; p < end; p += 4) {
+            c0 += p[0];
+            c1 += p[1];
+            c2 += p[2];
+        }
+    }
+
+    sums.c0 += c0;
+    sums.c1 += c1;
+    sums.c2 += c2;
+}
+
+void ShufflePixelsToRGBAScalar(const uint8_t* row, const int* columns, int count, const uint8_t order[4], uint8_t* dst) {
+    for (int x = 0; x < count; x++) {
+        const uint8_t* p = row + static_cast<size_t>(columns ? columns[x] : x) * 4;
+        dst[x * 4 + 0] = p[order[0]];
+        dst[x * 4 + 1] = p[order[1]];
+        dst[x * 4 + 2] = p[order[2]];
+        dst[x * 4 + 3] = p[order[3]];
+    }
+}
+
+#ifdef PIXELKERNELS_X86
+
+// Each 32-bit pixel is masked down to a single channel, then _sad_epu8 against zero adds
+// the remaining bytes into 64-bit lanes, so the accumulators can never overflow.
+
+PIXELKERNELS_TARGET_SSE2
+static void SumChannelsSSE2(const uint8_t* data, int width, int height, int stride, ChannelSums& sums) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128();
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = data + static_cast<size_t>(y) * stride;
+        int x = 0;
+
+        for (; x + 4 <= width; x += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+            acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_and_si128(v, mask), zero));
+            acc1 = _mm_add_epi64(acc1, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(v, 8), mask), zero));
+            acc2 = _mm_add_epi64(acc2, _mm_sad_epu8(_mm_and_si128(_mm_srli_epi32(v, 16), mask), zero));
+        }
+
+        for (; x < width; x++) {
+            c0 += row[x * 4 + 0];
+            c1 += row[x * 4 + 1];
+            c2 += row[x * 4 + 2];
+        }
+    }
+
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc0);
+    sums.c0 += c0 + lanes[0] + lanes[1];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc1);
+    sums.c1 += c1 + lanes[0] + lanes[1];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc2);
+    sums.c2 += c2 + lanes[0] + lanes[1];
+}
+
+PIXELKERNELS_TARGET_AVX2
+static void SumChannelsAVX2(const uint8_t* data, int width, int height, int stride, ChannelSums& sums) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = data + static_cast<size_t>(y) * stride;
+        int x = 0;
+
+        for (; x + 8 <= width; x += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + x * 4));
+            acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_and_si256(v, mask), zero));
+            acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(v, 8), mask), zero));
+            acc2 = _mm256_add_epi64(acc2, _mm256_sad_epu8(_mm256_and_si256(_mm256_srli_epi32(v, 16), mask), zero));
+        }
+
+        for (; x < width; x++) {
+            c0 += row[x * 4 + 0];
+            c1 += row[x * 4 + 1];
+            c2 += row[x * 4 + 2];
+        }
+    }
+
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc0);
+    sums.c0 += c0 + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc1);
+    sums.c1 += c1 + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc2);
+    sums.c2 += c2 + lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Four pixels per _mm_shuffle_epi8, gathered with 32-bit loads when decimating
+PIXELKERNELS_TARGET_SSSE3
+static void ShufflePixelsToRGBASSSE3(const uint8_t* row, const int* columns, int count, const uint8_t order[4], uint8_t* dst) {
+    const __m128i shuffle = _mm_setr_epi8(
+        order[0], order[1], order[2], order[3],
+        order[0] + 4, order[1] + 4, order[2] + 4, order[3] + 4,
+        order[0] + 8, order[1] + 8, order[2] + 8, order[3] + 8,
+        order[0] + 12, order[1] + 12, order[2] + 12, order[3] + 12);
+    int x = 0;
+
+    if (columns) {
+        for (; x + 4 <= count; x += 4) {
+            __m128i v = _mm_setr_epi32(
+                static_cast<int>(LoadPixel(row + static_cast<size_t>(columns[x + 0]) * 4)),
+                static_cast<int>(LoadPixel(row + static_cast<size_t>(columns[x + 1]) * 4)),
+                static_cast<int>(LoadPixel(row + static_cast<size_t>(columns[x + 2]) * 4)),
+                static_cast<int>(LoadPixel(row + static_cast<size_t>(columns[x + 3]) * 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_shuffle_epi8(v, shuffle));
+        }
+    }
+    else {
+        for (; x + 4 <= count; x += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_shuffle_epi8(v, shuffle));
+        }
+    }
+
+    // Remaining pixels
+    if (columns) {
+        ShufflePixelsToRGBAScalar(row, columns + x, count - x, order, dst + x * 4);
+    }
+    else {
+        ShufflePixelsToRGBAScalar(row + x * 4, nullptr, count - x, order, dst + x * 4);
+    }
+}
+
+static bool CpuHasSSE2() {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true; // Baseline on x64
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static bool CpuHasSSSE3() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+static bool CpuHasAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // The OS must save the YMM registers (OSXSAVE + XCR0 bits 1 and 2)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // PIXELKERNELS_X86
+
+#ifdef PIXELKERNELS_NEON
+
+static void SumChannelsNEON(const uint8_t* data, int width, int height, int stride, ChannelSums& sums) {
+    uint64x2_t acc0 = vdupq_n_u64(0);
+    uint64x2_t acc1 = vdupq_n_u64(0);
+    uint64x2_t acc2 = vdupq_n_u64(0);
+    uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = data + static_cast<size_t>(y) * stride;
+        int x = 0;
+
+        while (x + 16 <= width) {
+            // 16-bit lanes gain at most 510 per block, so flush to 32 bits every 128 blocks
+            uint16x8_t s0 = vdupq_n_u16(0);
+            uint16x8_t s1 = vdupq_n_u16(0);
+            uint16x8_t s2 = vdupq_n_u16(0);
+            int blocks = 0;
+
+            for (; x + 16 <= width && blocks < 128; x += 16, blocks++) {
+                uint8x16x4_t v = vld4q_u8(row + x * 4);
+                s0 = vpadalq_u8(s0, v.val[0]);
+                s1 = vpadalq_u8(s1, v.val[1]);
+                s2 = vpadalq_u8(s2, v.val[2]);
+            }
+
+            acc0 = vpadalq_u32(acc0, vpaddlq_u16(s0));
+            acc1 = vpadalq_u32(acc1, vpaddlq_u16(s1));
+            acc2 = vpadalq_u32(acc2, vpaddlq_u16(s2));
+        }
+
+        for (; x < width; x++) {
+            c0 += row[x * 4 + 0];
+            c1 += row[x * 4 + 1];
+            c2 += row[x * 4 + 2];
+        }
+    }
+
+    sums.c0 += c0 + vgetq_lane_u64(acc0, 0) + vgetq_lane_u64(acc0, 1);
+    sums.c1 += c1 + vgetq_lane_u64(acc1, 0) + vgetq_lane_u64(acc1, 1);
+    sums.c2 += c2 + vgetq_lane_u64(acc2, 0) + vgetq_lane_u64(acc2, 1);
+}
+
+// Four pixels per vqtbl1q_u8, gathered through a small array when decimating
+static void ShufflePixelsToRGBANEON(const uint8_t* row, const int* columns, int count, const uint8_t order[4], uint8_t* dst) {
+    const uint8_t indices[16] = {
+        order[0], order[1], order[2], order[3],
+        uint8_t(order[0] + 4), uint8_t(order[1] + 4), uint8_t(order[2] + 4), uint8_t(order[3] + 4),
+        uint8_t(order[0] + 8), uint8_t(order[1] + 8), uint8_t(order[2] + 8), uint8_t(order[3] + 8),
+        uint8_t(order[0] + 12), uint8_t(order[1] + 12), uint8_t(order[2] + 12), uint8_t(order[3] + 12)
+    };
+    const uint8x16_t shuffle = vld1q_u8(indices);
+    int x = 0;
+
+    if (columns) {
+        uint32_t pixels[4];
+        for (; x + 4 <= count; x += 4) {
+            pixels[0] = LoadPixel(row + static_cast<size_t>(columns[x + 0]) * 4);
+            pixels[1] = LoadPixel(row + static_cast<size_t>(columns[x + 1]) * 4);
+            pixels[2] = LoadPixel(row + static_cast<size_t>(columns[x + 2]) * 4);
+            pixels[3] = LoadPixel(row + static_cast<size_t>(columns[x + 3]) * 4);
+            uint8x16_t v = vreinterpretq_u8_u32(vld1q_u32(pixels));
+            vst1q_u8(dst + x * 4, vqtbl1q_u8(v, shuffle));
+        }
+    }
+    else {
+        for (; x + 4 <= count; x += 4) {
+            vst1q_u8(dst + x * 4, vqtbl1q_u8(vld1q_u8(row + x * 4), shuffle));
+        }
+    }
+
+    // Remaining pixels
+    if (columns) {
+        ShufflePixelsToRGBAScalar(row, columns + x, count - x, order, dst + x * 4);
+    }
+    else {
+        ShufflePixelsToRGBAScalar(row + x * 4, nullptr, count - x, order, dst + x * 4);
+    }
+}
+
+#endif // PIXELKERNELS_NEON
+
+struct PixelKernelTable {
+    SumChannelsFn sumChannels;
+    ShufflePixelsFn shufflePixels;
+    char name[32]; // Of both, "sum/shuffle"
+};
+
+static PixelKernelTable SelectPixelKernels() {
+    PixelKernelTable table = { SumChannelsScalar, ShufflePixelsToRGBAScalar, {} };
+    const char* sumName = "Scalar";
+    const char* shuffleName = "Scalar";
+
+#if defined(PIXELKERNELS_X86)
+    if (CpuHasSSE2()) {
+        table.sumChannels = SumChannelsSSE2;
+        sumName = "SSE2";
+    }
+    if (CpuHasSSSE3()) {
+        table.shufflePixels = ShufflePixelsToRGBASSSE3;
+        shuffleName = "SSSE3";
+    }
+    if (CpuHasAVX2()) {
+        table.sumChannels = SumChannelsAVX2;
+        sumName = "AVX2";
+    }
+#elif defined(PIXELKERNELS_NEON)
+    table.sumChannels = SumChannelsNEON;
+    table.shufflePixels = ShufflePixelsToRGBANEON;
+    sumName = "NEON";
+    shuffleName = "NEON";
+#endif
+
+    std::snprintf(table.name, sizeof(table.name), "%s/%s", sumName, shuffleName);
+    return table;
+}
+
+// Selected once, on first use
+static const PixelKernelTable& GetPixelKernels() {
+    static const PixelKernelTable table = SelectPixelKernels();
+    return table;
+}
+
+void SumChannels(const uint8_t* data, int width, int height, int stride, ChannelSums& sums) {
+    GetPixelKernels().sumChannels(data, width, height, stride, sums);
+}
+
+void ShufflePixelsToRGBA(const uint8_t* row, const int* columns, int count, const uint8_t order[4], uint8_t* dst) {
+    GetPixelKernels().shufflePixels(row, columns, count, order, dst);
+}
+
+const char* GetPixelKernelName() {
+    return GetPixelKernels().name;
+}
@@ -0,0 +1,30 @@
+// PixelKernels.h
+#pragma once
+
+#include <cstdint>
+
+// Per-channel sums over 4-byte pixels, indexed by byte position within the pixel
+struct ChannelSums {
+    uint64_t c0 = 0;
+    uint64_t c1 = 0;
+    uint64_t c2 = 0;
+};
+
+// Adds the first three channels of every pixel in the image to sums.
+// The implementation (AVX2, SSE2, NEON or scalar) is selected once at startup from the CPU
+// features and always produces exactly the same sums as the scalar version.
+void SumChannels(const uint8_t* data, int width, int height, int stride, ChannelSums& sums);
+
+// Scalar reference version of SumChannels, always available
+void SumChannelsScalar(const uint8_t* data, int width, int height, int stride, ChannelSums& sums);
+
+// Writes count pixels of row to dst as RGBA8, taking the R, G, B and A bytes of each source
+// pixel from the offsets in order. columns holds the source pixel index of every output pixel,
+// or is null to convert the first count pixels of row. SSSE3 and NEON use a byte shuffle.
+void ShufflePixelsToRGBA(const uint8_t* row, const int* columns, int count, const uint8_t order[4], uint8_t* dst);
+
+// Scalar reference version of ShufflePixelsToRGBA, always available
+void ShufflePixelsToRGBAScalar(const uint8_t* row, const int* columns, int count, const uint8_t order[4], uint8_t* dst);
+
+// Names of the implementations selected for SumChannels and ShufflePixelsToRGBA, e.g. "AVX2/SSSE3"
+const char* GetPixelKernelName();
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// PreviewGenerator.cpp
+
+#include "PreviewGenerator.h"
+#include "PixelKernels.h"
+#include <algorithm>
+
+PreviewGenerator::PreviewGenerator()
+    : sourceWidth(0) {
+}
+
+void PreviewGenerator::GetPreviewSize(int width, int height, int maxWidth, int maxHeight, int& previewWidth, int& previewHeight) {
+    previewWidth = width;
+    previewHeight = height;
+
+    if (width <= 0 || height <= 0 || maxWidth <= 0 || maxHeight <= 0) {
+        return;
+    }
+
+    if (width > maxWidth || height > maxHeight) {
+        float scale = std::min(
+            static_cast<float>(maxWidth) / width,
+            static_cast<float>(maxHeight) / height
+        );
+
+        previewWidth = std::clamp(static_cast<int>(width * scale + 0.5f), 1, width);
+        previewHeight = std::clamp(static_cast<int>(height * scale + 0.5f), 1, height);
+    }
+}
+
+bool PreviewGenerator::Generate(const BitmapView& frame, int maxWidth, int maxHeight) {
+    return Generate(frame, maxWidth, maxHeight, preview);
+}
+
+bool PreviewGenerator::Generate(const BitmapView& frame, int maxWidth, int maxHeight, Bitmap& target) {
+    if (!frame.IsValid()) {
+        return false;
+    }
+
+    int previewWidth = 0;
+    int previewHeight = 0;
+    GetPreviewSize(frame.width, frame.height, maxWidth, maxHeight, previewWidth, previewHeight);
+
+    if (!target.IsValid() || target.width != previewWidth || target.height != previewHeight) {
+        target = Bitmap(previewWidth, previewHeight, PixelFormat::RGBA8);
+    }
+
+    // Nearest sample at the centre of every preview column, recomputed only when the sizes change
+    if (frame.width != sourceWidth || static_cast<int>(columns.size()) != previewWidth) {
+        columns.resize(previewWidth);
+        for (int x = 0; x < previewWidth; x++) {
+            columns[x] = static_cast<int>((2LL * x + 1) * frame.width / (2LL * previewWidth));
+        }
+        sourceWidth = frame.width;
+    }
+
+    // Byte of the source pixel that goes to each RGBA output byte
+    uint8_t order[4];
+    DispatchPixelFormat(frame.format, [&](auto layout) {
+        typedef decltype(layout) Layout;
+        order[0] = Layout::Red;
+        order[1] = Layout::Green;
+        order[2] = Layout::Blue;
+        order[3] = Layout::Alpha;
+    });
+
+    // Full width previews read rows contiguously
+    const int* columnMap = previewWidth == frame.width ? nullptr : columns.data();
+
+    for (int y = 0; y < previewHeight; y++) {
+        int srcY = static_cast<int>((2LL * y + 1) * frame.height / (2LL * previewHeight));
+        const uint8_t* src = frame.data + static_cast<size_t>(srcY) * frame.stride;
+        uint8_t* dst = target.data.get() + static_cast<size_t>(y) * target.stride;
+
+        ShufflePixelsToRGBA(src, columnMap, previewWidth, order, dst);
+    }
+
+    return true;
+}
@@ -0,0 +1,31 @@
+// PreviewGenerator.h
+#pragma once
+
+#include <vector>
+#include "ColorProcessor.h" // For Bitmap, BitmapView
+
+// Builds the debug view preview from a captured frame.
+// The frame is decimated to the size the preview is displayed at and converted to RGBA8 in a
+// single pass, so the texture upload only ever receives a small, already formatted buffer.
+class PreviewGenerator {
+private:
+    Bitmap preview;
+    std::vector<int> columns; // Source column of every preview column
+    int sourceWidth;          // Frame width the columns were computed for
+
+public:
+    PreviewGenerator();
+
+    // Size of a preview of a width x height frame that fits in maxWidth x maxHeight.
+    // The aspect ratio is kept and frames are never enlarged.
+    static void GetPreviewSize(int width, int height, int maxWidth, int maxHeight, int& previewWidth, int& previewHeight);
+
+    // Regenerates the preview from frame, returns false if there is nothing to show
+    bool Generate(const BitmapView& frame, int maxWidth, int maxHeight);
+    // Same, into target instead of the generator's own preview. target is only reallocated
+    // when the size changes, so a caller can keep several previews alive without copying.
+    bool Generate(const BitmapView& frame, int maxWidth, int maxHeight, Bitmap& target);
+
+    // RGBA8 preview, rows are tightly packed
+    const Bitmap& GetPreview() const { return preview; }
+};
@@ -0,0 +1,99 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// ReplayFrameSource.cpp
+
+#include "ReplayFrameSource.h"
+#include <algorithm>
+
+ReplayFrameSource::ReplayFrameSource(const std::string& path, double speed, bool loop)
+    : path(path), speed(std::max(speed, 0.0)), loop(loop), nextFrame(0), loopStartUs(0), format(PixelFormat::BGRA8) {
+}
+
+bool ReplayFrameSource::Open(std::string& error) {
+    if (!reader.Open(path, error)) {
+        return false;
+    }
+    if (reader.GetFrameCount() == 0) {
+        error = "The recording \"" + path + "\" has no frames";
+        reader.Close();
+        return false;
+    }
+
+    nextFrame = 0;
+    loopStartUs = 0;
+    startTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+void ReplayFrameSource::Close() {
+    reader.Close();
+}
+
+CaptureResult ReplayFrameSource::AcquireFrame(CapturedFrame& frame) {
+    auto now = std::chrono::steady_clock::now();
+    size_t frameCount = reader.GetFrameCount();
+    size_t index;
+    std::chrono::steady_clock::time_point timestamp;
+
+    if (speed <= 0.0) {
+        if (nextFrame >= frameCount) {
+            if (!loop) {
+                return CaptureResult::SourceLost;
+            }
+            nextFrame = 0;
+            loopStartUs += GetLengthUs();
+        }
+        index = nextFrame++;
+
+        // The recorded timing, not the time of the capture
+        timestamp = startTime + std::chrono::microseconds(loopStartUs + reader.GetFrame(index).timestampUs);
+    }
+    else {
+        int64_t lengthUs = GetLengthUs();
+        int64_t positionUs = static_cast<int64_t>(std::chrono::duration<double, std::micro>(now - startTime).count() * speed);
+
+        if (positionUs >= lengthUs) {
+            if (!loop) {
+                return CaptureResult::SourceLost;
+            }
+            positionUs %= lengthUs;
+        }
+        index = reader.FindFrame(positionUs);
+
+        // Back by how long the frame has been on the replayed screen
+        int64_t shownForUs = static_cast<int64_t>((positionUs - reader.GetFrame(index).timestampUs) / speed);
+        timestamp = now - std::chrono::microseconds(shownForUs);
+    }
+
+    frame.bitmap = reader.GetBitmap(index);
+    frame.timestamp = timestamp;
+    frame.crop = reader.GetFrame(index).crop;
+    format = frame.bitmap.format;
+    return CaptureResult::Captured;
+}
+
+int64_t ReplayFrameSource::GetLengthUs() const {
+    size_t frameCount = reader.GetFrameCount();
+    int64_t durationUs = reader.GetDurationUs();
+    return std::max<int64_t>(durationUs + (frameCount > 1 ? durationUs / static_cast<int64_t>(frameCount - 1) : 0), 1);
+}
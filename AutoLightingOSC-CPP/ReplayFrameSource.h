@@ -0,0 +1,40 @@
+// ReplayFrameSource.h
+#pragma once
+
+#include <chrono>
+#include <string>
+#include "FrameRecording.h"
+#include "IFrameSource.h"
+
+// Plays a FrameRecording back as if it were the screen. At a positive speed every capture gets
+// the frame that was on screen at that point of the recording (1 is real time, 2 twice as fast);
+// at speed 0 every capture gets the next frame, so each one is processed exactly once and in
+// order, however fast the captures come, and is stamped with the time it was recorded at (from
+// when the replay was opened, and running on across loops). Frames keep the crop they were
+// recorded with.
+class ReplayFrameSource : public IFrameSource {
+private:
+    std::string path;
+    double speed;
+    bool loop; // Start over at the end instead of reporting the source lost
+
+    FrameRecordingReader reader;
+    size_t nextFrame;    // Speed 0
+    int64_t loopStartUs; // Speed 0: replay time the current pass through the recording began at
+    std::chrono::steady_clock::time_point startTime;
+    PixelFormat format;
+
+    // The last frame stays up for the average frame interval before the recording ends
+    int64_t GetLengthUs() const;
+
+public:
+    ReplayFrameSource(const std::string& path, double speed = 1.0, bool loop = false);
+
+    bool Open(std::string& error) override;
+    void Close() override;
+    CaptureResult AcquireFrame(CapturedFrame& frame) override;
+
+    PixelFormat GetFormat() const override { return format; }
+    bool IsPaced() const override { return speed > 0.0; }
+    std::string GetDescription() const override { return path; }
+};
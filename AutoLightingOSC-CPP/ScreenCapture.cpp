@@ -199,7 +199,8 @@ Bitmap ScreenCapture::Capture(const RECT& captureArea) {
             return Bitmap();
         }
 
-        Bitmap result(width, height);
+        // Desktop duplication frames are DXGI_FORMAT_B8G8R8A8_UNORM
+        Bitmap result(width, height, PixelFormat::BGRA8);
 
         // Copy pixel data
         for (int y = 0; y < height; y++) {
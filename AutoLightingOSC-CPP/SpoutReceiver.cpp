@@ -103,6 +103,19 @@ bool SpoutReceiver::Connect() {
     return false; // No sender found
 }
 
+// Senders are usually RGBA, but DXGI BGRA textures are shared as well
+static PixelFormat GetPixelFormat(DXGI_FORMAT format) {
+    switch (format) {
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8X8_UNORM:
+    case DXGI_FORMAT_B8G8R8X8_UNORM_SRGB:
+        return PixelFormat::BGRA8;
+    default:
+        return PixelFormat::RGBA8;
+    }
+}
+
 Bitmap SpoutReceiver::Receive() {
     if (!isInitialized) {
         std::cerr << "Spout not initialized in Receive()" << std::endl;
@@ -173,7 +186,7 @@ Bitmap SpoutReceiver::Receive() {
     D3D11_MAPPED_SUBRESOURCE mappedResource;
     hr = context->Map(stagingTexture, 0, D3D11_MAP_READ, 0, &mappedResource);
     if (SUCCEEDED(hr)) {
-        Bitmap result(width, height);
+        Bitmap result(width, height, GetPixelFormat(desc.Format));
 
         // Copy row by row to account for potential stride differences
         for (unsigned int y = 0; y < height; y++) {
@@ -0,0 +1,52 @@
+// SpscRing.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Neither side ever blocks: TryPush fails when the ring is full and TryPop when it is empty.
+template <typename T, size_t Capacity>
+class SpscRing {
+private:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    // Free-running counters, masked into items. Kept on separate cache lines so the
+    // producer and consumer do not invalidate each other's line on every operation.
+    alignas(64) std::atomic<size_t> head{ 0 }; // Next item to pop, written by the consumer
+    alignas(64) std::atomic<size_t> tail{ 0 }; // Next slot to push, written by the producer
+    T items[Capacity];
+
+public:
+    static constexpr size_t GetCapacity() { return Capacity; }
+
+    // Producer only
+    bool TryPush(const T& item) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        items[position & (Capacity - 1)] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool TryPop(T& item) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = items[position & (Capacity - 1)];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called while the other side is running
+    size_t GetSize() const {
+        size_t position = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - position;
+    }
+};
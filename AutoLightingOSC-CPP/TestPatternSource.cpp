@@ -0,0 +1,71 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// TestPatternSource.cpp
+
+#include "TestPatternSource.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+TestPatternSource::TestPatternSource(double periodSeconds, int w, int h)
+    : width(std::max(w, 1)), height(std::max(h, 1)), period(std::max(periodSeconds, 0.1)),
+    startTime(std::chrono::steady_clock::now()) {
+}
+
+bool TestPatternSource::Open(std::string&) {
+    startTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+CaptureResult TestPatternSource::AcquireFrame(CapturedFrame& frame) {
+    frame.timestamp = std::chrono::steady_clock::now();
+
+    // Fully saturated colour at the current point of the hue cycle
+    double seconds = std::chrono::duration<double>(frame.timestamp - startTime).count();
+    double hue = std::fmod(seconds / period, 1.0) * 6.0;
+    double fraction = hue - std::floor(hue);
+    uint8_t rising = static_cast<uint8_t>(std::lround(fraction * 255.0));
+    uint8_t falling = static_cast<uint8_t>(255 - rising);
+
+    uint8_t r, g, b;
+    switch (static_cast<int>(hue)) {
+    case 0: r = 255; g = rising; b = 0; break;
+    case 1: r = falling; g = 255; b = 0; break;
+    case 2: r = 0; g = 255; b = rising; break;
+    case 3: r = 0; g = falling; b = 255; break;
+    case 4: r = rising; g = 0; b = 255; break;
+    default: r = 255; g = 0; b = falling; break;
+    }
+
+    frame.bitmap = Bitmap(width, height, PixelFormat::BGRA8);
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = frame.bitmap.data.get() + static_cast<size_t>(y) * frame.bitmap.stride;
+        for (int x = 0; x < width; x++) {
+            row[x * 4 + 0] = b;
+            row[x * 4 + 1] = g;
+            row[x * 4 + 2] = r;
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return CaptureResult::Captured;
+}
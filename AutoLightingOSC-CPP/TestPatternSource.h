@@ -0,0 +1,21 @@
+// TestPatternSource.h
+#pragma once
+
+#include <chrono>
+#include "IFrameSource.h"
+
+// Solid frames cycling through every hue, to run the whole pipeline without a capture backend
+class TestPatternSource : public IFrameSource {
+private:
+    int width;
+    int height;
+    double period; // Seconds for one cycle through the hues
+    std::chrono::steady_clock::time_point startTime;
+
+public:
+    TestPatternSource(double periodSeconds = 10.0, int width = 640, int height = 360);
+
+    bool Open(std::string& error) override;
+    void Close() override {}
+    CaptureResult AcquireFrame(CapturedFrame& frame) override;
+};
@@ -0,0 +1,46 @@
+// TripleBuffer.h
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Latest-value handoff from exactly one writer thread to one reader thread. The writer fills
+// its own slot and publishes it, the reader takes the newest published slot. Neither side ever
+// waits for the other, and values the reader never took are simply overwritten.
+template <typename T>
+class TripleBuffer {
+private:
+    // Low bits of shared: the slot between the two sides. NewBit: it holds a value the reader has not taken.
+    static const uint8_t IndexMask = 3;
+    static const uint8_t NewBit = 4;
+
+    T slots[3];
+    alignas(64) std::atomic<uint8_t> shared{ 1 };
+    alignas(64) uint8_t writeIndex = 0; // Writer only
+    alignas(64) uint8_t readIndex = 2;  // Reader only
+
+public:
+    // Writer only: the slot to fill before Publish. It holds whatever was written to it
+    // three publishes ago, so every field has to be written again.
+    T& GetWriteBuffer() { return slots[writeIndex]; }
+
+    // Writer only
+    void Publish() {
+        uint8_t previous = shared.exchange(static_cast<uint8_t>(writeIndex | NewBit), std::memory_order_acq_rel);
+        writeIndex = previous & IndexMask;
+    }
+
+    // Reader only: takes the newest published value, false if nothing was published since the last call
+    bool Update() {
+        if (!(shared.load(std::memory_order_relaxed) & NewBit)) {
+            return false;
+        }
+
+        uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & IndexMask;
+        return true;
+    }
+
+    // Reader only: the value taken by the last successful Update, default-constructed before that
+    const T& GetReadBuffer() const { return slots[readIndex]; }
+};
@@ -0,0 +1,348 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// UdpTransport.cpp
+
+#include "UdpTransport.h"
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#ifdef _WIN32
+static const uintptr_t InvalidSocketHandle = static_cast<uintptr_t>(INVALID_SOCKET);
+static int GetLastSocketError() { return WSAGetLastError(); }
+#else
+static const int InvalidSocketHandle = -1;
+static int GetLastSocketError() { return errno; }
+#endif
+
+constexpr std::chrono::milliseconds UdpTransport::InitialReopenDelay;
+constexpr std::chrono::milliseconds UdpTransport::MaxReopenDelay;
+
+UdpTransport::UdpTransport()
+    : socketHandle(InvalidSocketHandle), reopenDelay(InitialReopenDelay) {
+}
+
+UdpTransport::~UdpTransport() {
+    Close();
+}
+
+bool UdpTransport::Open() {
+    if (IsOpen()) {
+        return true;
+    }
+    stats.openAttempts++;
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    int startupError = WSAStartup(MAKEWORD(2, 2), &wsaData);
+    if (startupError != 0) {
+        std::cerr << "Error initializing Winsock: " << startupError << std::endl;
+        return false;
+    }
+
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_SOCKET) {
+        std::cerr << "Error creating UDP socket: " << WSAGetLastError() << std::endl;
+        WSACleanup();
+        return false;
+    }
+
+    // Sends must never block the caller, a full buffer drops the datagram instead
+    u_long nonBlocking = 1;
+    ioctlsocket(handle, FIONBIO, &nonBlocking);
+    socketHandle = static_cast<SocketHandle>(handle);
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle < 0) {
+        std::cerr << "Error creating UDP socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Sends must never block the caller, a full buffer drops the datagram instead
+    fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK);
+    socketHandle = handle;
+#endif
+
+    return true;
+}
+
+bool UdpTransport::EnsureOpen() {
+    if (IsOpen()) {
+        return true;
+    }
+    if (std::chrono::steady_clock::now() < nextOpenTime) {
+        return false;
+    }
+
+    if (Open()) {
+        return true;
+    }
+    ScheduleReopen();
+    return false;
+}
+
+void UdpTransport::ScheduleReopen() {
+    nextOpenTime = std::chrono::steady_clock::now() + reopenDelay;
+    reopenDelay = std::min(reopenDelay * 2, MaxReopenDelay);
+}
+
+void UdpTransport::Close() {
+    if (!IsOpen()) {
+        return;
+    }
+
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(socketHandle));
+    WSACleanup();
+#else
+    close(socketHandle);
+#endif
+    socketHandle = InvalidSocketHandle;
+}
+
+bool UdpTransport::IsOpen() const {
+    return socketHandle != InvalidSocketHandle;
+}
+
+size_t UdpTransport::AddDestination(const std::string& address, int port) {
+    Destination destination = {};
+    destination.port = htons(static_cast<uint16_t>(port));
+
+    in_addr resolved = {};
+    if (inet_pton(AF_INET, address.c_str(), &resolved) == 1) {
+        destination.valid = true;
+    }
+    else {
+        // Host name, only resolved here so sends never block on DNS
+        addrinfo hints = {};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+
+        addrinfo* results = nullptr;
+        if (getaddrinfo(address.c_str(), nullptr, &hints, &results) == 0 && results) {
+            resolved = reinterpret_cast<const sockaddr_in*>(results->ai_addr)->sin_addr;
+            destination.valid = true;
+        }
+        else {
+            std::cerr << "Could not resolve OSC destination " << address << std::endl;
+        }
+        if (results) {
+            freeaddrinfo(results);
+        }
+    }
+    std::memcpy(&destination.address, &resolved, sizeof(destination.address));
+
+    destinations.push_back(destination);
+
+#ifdef __linux__
+    sockaddr_in socketAddress = {};
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = destination.port;
+    socketAddress.sin_addr = resolved;
+    socketAddresses.push_back(socketAddress);
+#endif
+
+    return destinations.size() - 1;
+}
+
+void UdpTransport::ClearDestinations() {
+    destinations.clear();
+#ifdef __linux__
+    socketAddresses.clear();
+#endif
+}
+
+UdpTransport::SendError UdpTransport::ClassifyError(int error) {
+    switch (error) {
+#ifdef _WIN32
+    case WSAEWOULDBLOCK:
+    case WSAENOBUFS:
+        return SendError::WouldBlock;
+    case WSAECONNREFUSED:
+    case WSAECONNRESET: // Reported by Windows after an ICMP port unreachable
+        return SendError::Refused;
+    case WSAENOTSOCK:
+    case WSANOTINITIALISED:
+    case WSAESHUTDOWN:
+        return SendError::Fatal;
+#else
+    case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case ENOBUFS:
+        return SendError::WouldBlock;
+    case ECONNREFUSED:
+        return SendError::Refused;
+    case EBADF:
+    case ENOTSOCK:
+        return SendError::Fatal;
+#endif
+    default:
+        return SendError::Other;
+    }
+}
+
+bool UdpTransport::RecordError(size_t destination, int error) {
+    DestinationStats& destinationStats = destinations[destination].stats;
+    destinationStats.lastError = error;
+
+    switch (ClassifyError(error)) {
+    case SendError::WouldBlock:
+        destinationStats.wouldBlock++;
+        break;
+    case SendError::Refused:
+        destinationStats.refused++;
+        break;
+    case SendError::Other:
+        destinationStats.otherErrors++;
+        break;
+    case SendError::Fatal:
+        destinationStats.otherErrors++;
+        stats.fatalErrors++;
+        std::cerr << "UDP socket failed (" << error << "), reopening" << std::endl;
+        Close();
+        ScheduleReopen();
+        return false;
+    }
+    return true;
+}
+
+size_t UdpTransport::Send(const Datagram* datagrams, size_t count) {
+    if (!IsOpen()) {
+        return 0;
+    }
+
+    size_t sent = 0;
+
+#ifdef __linux__
+    if (messages.size() < count) {
+        messages.resize(count);
+        buffers.resize(count);
+        batchDestinations.resize(count);
+    }
+
+    // Datagrams for unresolved destinations are left out of the batch
+    size_t prepared = 0;
+    for (size_t i = 0; i < count; i++) {
+        const Datagram& datagram = datagrams[i];
+        if (!destinations[datagram.destination].valid) {
+            destinations[datagram.destination].stats.otherErrors++;
+            continue;
+        }
+
+        buffers[prepared].iov_base = const_cast<char*>(datagram.data);
+        buffers[prepared].iov_len = datagram.size;
+
+        mmsghdr& message = messages[prepared];
+        message = mmsghdr();
+        message.msg_hdr.msg_name = &socketAddresses[datagram.destination];
+        message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        message.msg_hdr.msg_iov = &buffers[prepared];
+        message.msg_hdr.msg_iovlen = 1;
+
+        batchDestinations[prepared] = datagram.destination;
+        prepared++;
+    }
+
+    // sendmmsg stops at the first datagram that fails, so that one is recorded against its
+    // destination and the rest of the batch is sent on
+    size_t next = 0;
+    while (next < prepared) {
+        int result = sendmmsg(socketHandle, &messages[next], static_cast<unsigned int>(prepared - next), MSG_DONTWAIT);
+        if (result < 0) {
+            int error = GetLastSocketError();
+            if (error == EINTR) {
+                continue;
+            }
+
+            // The buffer is shared by every destination, so the rest of the batch would fail too
+            if (ClassifyError(error) == SendError::WouldBlock) {
+                for (; next < prepared; next++) {
+                    RecordError(batchDestinations[next], error);
+                }
+                break;
+            }
+
+            if (!RecordError(batchDestinations[next], error)) {
+                break;
+            }
+            next++;
+            continue;
+        }
+
+        for (size_t i = next; i < next + result; i++) {
+            destinations[batchDestinations[i]].stats.sentPackets++;
+        }
+        sent += result;
+        next += result;
+    }
+#else
+    for (size_t i = 0; i < count; i++) {
+        const Datagram& datagram = datagrams[i];
+        Destination& destination = destinations[datagram.destination];
+        if (!destination.valid) {
+            destination.stats.otherErrors++;
+            continue;
+        }
+
+        sockaddr_in socketAddress = {};
+        socketAddress.sin_family = AF_INET;
+        socketAddress.sin_port = destination.port;
+        std::memcpy(&socketAddress.sin_addr, &destination.address, sizeof(destination.address));
+
+#ifdef _WIN32
+        int result = sendto(static_cast<SOCKET>(socketHandle), datagram.data, static_cast<int>(datagram.size), 0,
+            reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress));
+#else
+        ssize_t result = sendto(socketHandle, datagram.data, datagram.size, 0,
+            reinterpret_cast<const sockaddr*>(&socketAddress), sizeof(socketAddress));
+#endif
+        if (result < 0) {
+            if (!RecordError(datagram.destination, GetLastSocketError())) {
+                break;
+            }
+            continue;
+        }
+
+        destination.stats.sentPackets++;
+        sent++;
+    }
+#endif
+
+    // The socket works again, so the next failure starts from the shortest delay
+    if (sent > 0) {
+        reopenDelay = InitialReopenDelay;
+    }
+    return sent;
+}
@@ -0,0 +1,108 @@
+// UdpTransport.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+// One unconnected, non-blocking UDP socket that sends to any number of IPv4 destinations.
+// A batch of datagrams goes out in a single sendmmsg call on Linux (a sendto loop elsewhere),
+// and a failure is only recorded against the destination it was addressed to. Only errors
+// that leave the socket unusable close it, it is then reopened with exponential backoff.
+class UdpTransport {
+public:
+    struct Datagram {
+        size_t destination;
+        const char* data;
+        size_t size;
+    };
+
+    struct DestinationStats {
+        uint64_t sentPackets = 0;
+        uint64_t wouldBlock = 0;  // Socket buffer full, the datagram was dropped
+        uint64_t refused = 0;     // Nothing listening on the port (ICMP port unreachable)
+        uint64_t otherErrors = 0; // Unresolved address, unreachable network, ...
+        int lastError = 0;        // errno / WSAGetLastError of the last failed send, 0 if none
+    };
+
+    struct Stats {
+        uint64_t fatalErrors = 0;  // Errors that closed the socket
+        uint64_t openAttempts = 0; // Including the first open
+    };
+
+private:
+    // Plain integers so this header does not pull winsock into files that include windows.h
+#ifdef _WIN32
+    typedef uintptr_t SocketHandle; // SOCKET
+#else
+    typedef int SocketHandle;
+#endif
+
+    struct Destination {
+        uint32_t address; // IPv4, network byte order
+        uint16_t port;    // Network byte order
+        bool valid;       // False if the address could not be resolved, its sends count as errors
+        DestinationStats stats;
+    };
+
+    // Reopen delay after a failure, doubled on every consecutive one
+    static constexpr std::chrono::milliseconds InitialReopenDelay{ 100 };
+    static constexpr std::chrono::milliseconds MaxReopenDelay{ 10000 };
+
+    enum class SendError {
+        WouldBlock,
+        Refused,
+        Fatal,
+        Other
+    };
+
+    SocketHandle socketHandle;
+    std::vector<Destination> destinations;
+    Stats stats;
+    std::chrono::steady_clock::time_point nextOpenTime;
+    std::chrono::milliseconds reopenDelay;
+
+#ifdef __linux__
+    std::vector<sockaddr_in> socketAddresses; // Per destination, for msg_name
+    // Reused by every batch, so steady-state sends do not allocate
+    std::vector<struct mmsghdr> messages;
+    std::vector<struct iovec> buffers;
+    std::vector<size_t> batchDestinations;
+#endif
+
+    static SendError ClassifyError(int error);
+    // Returns false if the error closed the socket
+    bool RecordError(size_t destination, int error);
+    void ScheduleReopen();
+
+public:
+    UdpTransport();
+    ~UdpTransport();
+
+    UdpTransport(const UdpTransport&) = delete;
+    UdpTransport& operator=(const UdpTransport&) = delete;
+
+    bool Open();
+    void Close();
+    bool IsOpen() const;
+    // Opens the socket if it is closed and the backoff after the last failure has passed
+    bool EnsureOpen();
+
+    // Returns the index datagrams use to address it
+    size_t AddDestination(const std::string& address, int port);
+    void ClearDestinations();
+    size_t GetDestinationCount() const { return destinations.size(); }
+    const DestinationStats& GetDestinationStats(size_t destination) const { return destinations[destination].stats; }
+    const Stats& GetStats() const { return stats; }
+
+    // Sends every datagram and returns how many were accepted by the socket
+    size_t Send(const Datagram* datagrams, size_t count);
+};
@@ -24,16 +24,47 @@
 #include "UserSettings.h"
 #include <fstream>
 #include <iostream>
+#include <cstdlib>
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
 #include <ShlObj.h>
+#endif
 
 UserSettings::UserSettings() {
 }
 
+std::string UserSettings::GetCaptureSourceName() const {
+    if (enableSpout) {
+        return "spout";
+    }
+    return useDXGI ? "dxgi" : "wgc";
+}
+
 std::filesystem::path UserSettings::GetSettingsFilePath() {
+#ifdef _WIN32
     char appDataPath[MAX_PATH];
     SHGetFolderPathA(NULL, CSIDL_APPDATA, NULL, 0, appDataPath);
 
-    std::filesystem::path settingsDir = std::filesystem::path(appDataPath) / "AutoLightOSC";
+    std::filesystem::path configDir(appDataPath);
+#else
+    // XDG base directory, falling back to ~/.config
+    std::filesystem::path configDir;
+    const char* xdgConfigHome = std::getenv("XDG_CONFIG_HOME");
+    const char* home = std::getenv("HOME");
+
+    if (xdgConfigHome && *xdgConfigHome) {
+        configDir = xdgConfigHome;
+    }
+    else if (home && *home) {
+        configDir = std::filesystem::path(home) / ".config";
+    }
+    else {
+        configDir = std::filesystem::current_path();
+    }
+#endif
+
+    std::filesystem::path settingsDir = configDir / "AutoLightOSC";
     std::filesystem::path settingsFile = settingsDir / "settings.json";
 
     return settingsFile;
@@ -74,6 +105,32 @@ UserSettings UserSettings::Load() {
                 if (j.contains("oscRParameter")) settings.oscRParameter = j["oscRParameter"];
                 if (j.contains("oscGParameter")) settings.oscGParameter = j["oscGParameter"];
                 if (j.contains("oscBParameter")) settings.oscBParameter = j["oscBParameter"];
+                if (j.contains("oscUseBundles")) settings.oscUseBundles = j["oscUseBundles"];
+                if (j.contains("oscMtu")) settings.oscMtu = j["oscMtu"];
+                if (j.contains("oscQuantization")) settings.oscQuantization = j["oscQuantization"];
+                if (j.contains("oscRoundingMode")) settings.oscRoundingMode = j["oscRoundingMode"];
+                if (j.contains("oscDeadBand")) settings.oscDeadBand = j["oscDeadBand"];
+                if (j.contains("oscDeadBandThreshold")) settings.oscDeadBandThreshold = j["oscDeadBandThreshold"];
+                if (j.contains("oscKeepaliveMs")) settings.oscKeepaliveMs = j["oscKeepaliveMs"];
+                if (j.contains("oscReceiverPrecision")) settings.oscReceiverPrecision = j["oscReceiverPrecision"];
+                if (j.contains("oscRPrecisionBits")) settings.oscRPrecisionBits = j["oscRPrecisionBits"];
+                if (j.contains("oscGPrecisionBits")) settings.oscGPrecisionBits = j["oscGPrecisionBits"];
+                if (j.contains("oscBPrecisionBits")) settings.oscBPrecisionBits = j["oscBPrecisionBits"];
+                if (j.contains("oscAsync")) settings.oscAsync = j["oscAsync"];
+                if (j.contains("oscExtraDestinations")) {
+                    settings.oscExtraDestinations.clear();
+                    for (const auto& item : j["oscExtraDestinations"]) {
+                        OscDestination destination;
+                        if (item.contains("address")) destination.address = item["address"];
+                        if (item.contains("port")) destination.port = item["port"];
+                        if (item.contains("rParameter")) destination.rParameter = item["rParameter"];
+                        if (item.contains("gParameter")) destination.gParameter = item["gParameter"];
+                        if (item.contains("bParameter")) destination.bParameter = item["bParameter"];
+                        settings.oscExtraDestinations.push_back(destination);
+                    }
+                }
+                if (j.contains("zoneColumns")) settings.zoneColumns = j["zoneColumns"];
+                if (j.contains("zoneRows")) settings.zoneRows = j["zoneRows"];
 
                 file.close();
             }
@@ -113,6 +170,30 @@ void UserSettings::Save() const {
         j["oscRParameter"] = oscRParameter;
         j["oscGParameter"] = oscGParameter;
         j["oscBParameter"] = oscBParameter;
+        j["oscUseBundles"] = oscUseBundles;
+        j["oscMtu"] = oscMtu;
+        j["oscQuantization"] = oscQuantization;
+        j["oscRoundingMode"] = oscRoundingMode;
+        j["oscDeadBand"] = oscDeadBand;
+        j["oscDeadBandThreshold"] = oscDeadBandThreshold;
+        j["oscKeepaliveMs"] = oscKeepaliveMs;
+        j["oscReceiverPrecision"] = oscReceiverPrecision;
+        j["oscRPrecisionBits"] = oscRPrecisionBits;
+        j["oscGPrecisionBits"] = oscGPrecisionBits;
+        j["oscBPrecisionBits"] = oscBPrecisionBits;
+        j["oscAsync"] = oscAsync;
+        j["oscExtraDestinations"] = nlohmann::json::array();
+        for (const OscDestination& destination : oscExtraDestinations) {
+            j["oscExtraDestinations"].push_back({
+                { "address", destination.address },
+                { "port", destination.port },
+                { "rParameter", destination.rParameter },
+                { "gParameter", destination.gParameter },
+                { "bParameter", destination.bParameter }
+            });
+        }
+        j["zoneColumns"] = zoneColumns;
+        j["zoneRows"] = zoneRows;
 
         // Write to file
         std::ofstream file(settingsFile);
@@ -2,8 +2,22 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <filesystem>
-#include <nlohmann/json.hpp>
+
+// Another OSC receiver for the same colours, with its own parameter names
+struct OscDestination {
+    std::string address = "127.0.0.1";
+    int port = 9000;
+    std::string rParameter = "AL_Red";
+    std::string gParameter = "AL_Green";
+    std::string bParameter = "AL_Blue";
+
+    bool operator==(const OscDestination& other) const {
+        return address == other.address && port == other.port && rParameter == other.rParameter &&
+            gParameter == other.gParameter && bParameter == other.bParameter;
+    }
+};
 
 class UserSettings {
 public:
@@ -24,9 +38,27 @@ public:
     std::string oscRParameter = "AL_Red";
     std::string oscGParameter = "AL_Green";
     std::string oscBParameter = "AL_Blue";
+    bool oscUseBundles = false; // One #bundle datagram per update instead of one per parameter
+    int oscMtu = 1500;          // Bundles are split to keep datagrams within this size
+    int oscQuantization = 1000; // Values are sent in steps of 1 / oscQuantization, 0 sends them unrounded
+    std::string oscRoundingMode = "nearest"; // See ValueQuantizer::ParseRoundingMode
+    bool oscDeadBand = false;            // Only send parameters that changed
+    float oscDeadBandThreshold = 0.004f; // Change (in OSC units, -1 to 1) needed to send
+    int oscKeepaliveMs = 1000;           // Unchanged parameters are still resent this often
+    bool oscReceiverPrecision = false;   // Only send changes a receiver syncing at the bit depths below would see
+    int oscRPrecisionBits = 8;
+    int oscGPrecisionBits = 8;
+    int oscBPrecisionBits = 8;
+    bool oscAsync = false;               // Send from a background thread instead of the UI loop
+    std::vector<OscDestination> oscExtraDestinations; // Sent alongside 127.0.0.1:oscPort
+    int zoneColumns = 1;
+    int zoneRows = 1;
 
     UserSettings();
 
+    // Name of the frame source backend enableSpout and useDXGI select, see WindowsFrameSources.h
+    std::string GetCaptureSourceName() const;
+
     static UserSettings Load();
     void Save() const;
 
@@ -0,0 +1,100 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// ValueQuantizer.cpp
+
+#include "ValueQuantizer.h"
+#include <cmath>
+
+// Divisions above this would no longer keep float * divisions exact in a double
+static const int MaxDivisions = 1 << 24;
+
+ValueQuantizer::ValueQuantizer(int divisions, RoundingMode roundingMode)
+    : divisions(0), roundingMode(roundingMode) {
+    SetDivisions(divisions);
+}
+
+void ValueQuantizer::SetDivisions(int newDivisions) {
+    divisions = newDivisions > MaxDivisions ? MaxDivisions : newDivisions;
+}
+
+void ValueQuantizer::SetRoundingMode(RoundingMode mode) {
+    roundingMode = mode;
+}
+
+float ValueQuantizer::Quantize(float value) const {
+    if (divisions <= 0 || !std::isfinite(value)) {
+        return value;
+    }
+
+    double scaled = static_cast<double>(value) * divisions;
+    double steps;
+
+    switch (roundingMode) {
+    case RoundingMode::NearestAway:
+        steps = std::round(scaled);
+        break;
+    case RoundingMode::Down:
+        steps = std::floor(scaled);
+        break;
+    case RoundingMode::Up:
+        steps = std::ceil(scaled);
+        break;
+    case RoundingMode::TowardZero:
+        steps = std::trunc(scaled);
+        break;
+    case RoundingMode::NearestEven:
+    default:
+        steps = std::nearbyint(scaled); // Default FP environment rounds ties to even
+        break;
+    }
+
+    // steps is an integer below 2^24 for inputs in [-1, 1], so it converts to float exactly and
+    // the single division is correctly rounded, the same as parsing the decimal string.
+    // Staying in floating point also keeps the sign of zero, like "-0.000" does.
+    return static_cast<float>(steps) / static_cast<float>(divisions);
+}
+
+const char* ValueQuantizer::GetRoundingModeName(RoundingMode mode) {
+    switch (mode) {
+    case RoundingMode::NearestAway: return "nearest-away";
+    case RoundingMode::Down: return "down";
+    case RoundingMode::Up: return "up";
+    case RoundingMode::TowardZero: return "toward-zero";
+    case RoundingMode::NearestEven:
+    default: return "nearest";
+    }
+}
+
+bool ValueQuantizer::ParseRoundingMode(const std::string& name, RoundingMode& mode) {
+    const RoundingMode modes[] = {
+        RoundingMode::NearestEven, RoundingMode::NearestAway, RoundingMode::Down,
+        RoundingMode::Up, RoundingMode::TowardZero
+    };
+
+    for (RoundingMode candidate : modes) {
+        if (name == GetRoundingModeName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
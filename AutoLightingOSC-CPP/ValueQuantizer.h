@@ -0,0 +1,40 @@
+// ValueQuantizer.h
+#pragma once
+
+#include <string>
+
+enum class RoundingMode {
+    NearestEven, // Ties to even, matches printf("%.3f") / std::fixed formatting
+    NearestAway, // Ties away from zero
+    Down,        // Towards negative infinity
+    Up,          // Towards positive infinity
+    TowardZero
+};
+
+// Snaps values to a grid of 1 / divisions using plain arithmetic.
+// With 1000 divisions and NearestEven the result is bit-identical to formatting the value with
+// std::fixed << std::setprecision(3) and parsing it back with std::stof, without the locale
+// lookups and allocations: the product of a float and the divisions is exact in a double, so
+// the rounding sees the exact value just like the decimal formatter does.
+class ValueQuantizer {
+private:
+    int divisions;
+    RoundingMode roundingMode;
+
+public:
+    static const int DefaultDivisions = 1000;
+
+    ValueQuantizer(int divisions = DefaultDivisions, RoundingMode roundingMode = RoundingMode::NearestEven);
+
+    // 0 or less disables quantisation
+    void SetDivisions(int divisions);
+    void SetRoundingMode(RoundingMode mode);
+    int GetDivisions() const { return divisions; }
+    RoundingMode GetRoundingMode() const { return roundingMode; }
+
+    float Quantize(float value) const;
+
+    // Names used in settings.json: "nearest", "nearest-away", "down", "up", "toward-zero"
+    static const char* GetRoundingModeName(RoundingMode mode);
+    static bool ParseRoundingMode(const std::string& name, RoundingMode& mode);
+};
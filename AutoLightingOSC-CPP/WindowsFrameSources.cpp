@@ -0,0 +1,200 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// WindowsFrameSources.cpp
+
+#include "WindowsFrameSources.h"
+#include <memory>
+#include "ScreenCapture.h"
+#include "SpoutReceiver.h"
+#include "WindowManager.h"
+#include "WindowsGraphicsCapture.h"
+
+static const char* const WindowNotFoundError =
+    "Could not find the target window. Please make sure VRChat is running, or select another target application.";
+
+// DXGI Desktop Duplication of the area covered by the target window. The duplication (and its
+// own device) is only created when the source is first opened.
+class DxgiFrameSource : public IFrameSource {
+private:
+    const WindowsCaptureContext& context;
+    std::unique_ptr<ScreenCapture> screenCapture;
+
+public:
+    DxgiFrameSource(const WindowsCaptureContext& context) : context(context) {}
+
+    bool Open(std::string& error) override {
+        if (!context.getWindow()) {
+            error = WindowNotFoundError;
+            return false;
+        }
+        if (!screenCapture) {
+            screenCapture = std::make_unique<ScreenCapture>();
+        }
+        return true;
+    }
+
+    void Close() override {}
+
+    CaptureResult AcquireFrame(CapturedFrame& frame) override {
+        HWND window = context.getWindow();
+        if (!context.windowManager->IsWindowValid(window)) {
+            return CaptureResult::NoFrame;
+        }
+
+        // Update the capture area each time to follow the window
+        RECT area = context.windowManager->GetOptimalCaptureArea(window);
+        frame.bitmap = screenCapture->Capture(area);
+        frame.timestamp = std::chrono::steady_clock::now();
+        return frame.bitmap.IsValid() ? CaptureResult::Captured : CaptureResult::NoFrame;
+    }
+};
+
+// Windows Graphics Capture of the target window, following it when the target changes
+class WgcFrameSource : public IFrameSource {
+private:
+    const WindowsCaptureContext& context;
+    WindowsGraphicsCapture windowsGraphicsCapture;
+
+public:
+    WgcFrameSource(const WindowsCaptureContext& context) : context(context) {}
+
+    bool Open(std::string& error) override {
+        HWND window = context.getWindow();
+        if (!window) {
+            error = WindowNotFoundError;
+            return false;
+        }
+        if (!windowsGraphicsCapture.SetDevice(context.device, context.deviceContext)) {
+            error = "Windows Graphics Capture needs a D3D11 device";
+            return false;
+        }
+        windowsGraphicsCapture.StartCaptureWindow(window);
+        return true;
+    }
+
+    void Close() override {
+        windowsGraphicsCapture.StopCapture();
+    }
+
+    CaptureResult AcquireFrame(CapturedFrame& frame) override {
+        HWND window = context.getWindow();
+        if (!context.windowManager->IsWindowValid(window)) {
+            return CaptureResult::NoFrame;
+        }
+
+        if (windowsGraphicsCapture.GetCaptureWindow() != window) {
+            windowsGraphicsCapture.StartCaptureWindow(window);
+        }
+
+        // Update the capture area each time to follow the window
+        RECT area = context.windowManager->GetOptimalCaptureArea(window);
+        frame.bitmap = windowsGraphicsCapture.Capture(area);
+        frame.timestamp = std::chrono::steady_clock::now();
+        return frame.bitmap.IsValid() ? CaptureResult::Captured : CaptureResult::NoFrame;
+    }
+};
+
+// Frames from the first available Spout2 sender. The receiver opens DirectX on first use.
+class SpoutFrameSource : public IFrameSource {
+private:
+    const WindowsCaptureContext& context;
+    std::unique_ptr<SpoutReceiver> spoutReceiver;
+    int failCount = 0;
+    PixelFormat format = PixelFormat::BGRA8;
+
+public:
+    SpoutFrameSource(const WindowsCaptureContext& context) : context(context) {}
+
+    ~SpoutFrameSource() {
+        Close();
+    }
+
+    bool Open(std::string& error) override {
+        if (!spoutReceiver) {
+            spoutReceiver = std::make_unique<SpoutReceiver>();
+        }
+        if (!spoutReceiver->Init(context.device, context.deviceContext)) {
+            error = "Failed to initialize the Spout receiver.";
+            return false;
+        }
+        if (!spoutReceiver->Connect()) {
+            error = "Could not connect to any Spout sender. Please ensure a Spout sender is running.";
+            return false;
+        }
+        failCount = 0;
+        return true;
+    }
+
+    void Close() override {
+        if (spoutReceiver && spoutReceiver->IsConnected()) {
+            spoutReceiver->Disconnect();
+        }
+    }
+
+    CaptureResult AcquireFrame(CapturedFrame& frame) override {
+        // Check if the sender is still actively sending frames
+        if (!spoutReceiver->IsSenderActive()) {
+            spoutReceiver->Disconnect();
+            Sleep(1000); // Brief delay
+
+            if (!spoutReceiver->Connect()) {
+                return CaptureResult::NoFrame;
+            }
+        }
+
+        frame.bitmap = spoutReceiver->Receive();
+        frame.timestamp = std::chrono::steady_clock::now();
+        if (!frame.bitmap.IsValid()) {
+            // Only disconnect after multiple consecutive failures
+            if (++failCount > 10 && spoutReceiver->IsConnected()) {
+                spoutReceiver->Disconnect();
+                failCount = 0;
+                return CaptureResult::SourceLost;
+            }
+            return CaptureResult::NoFrame;
+        }
+
+        failCount = 0;
+        format = frame.bitmap.format;
+        return CaptureResult::Captured;
+    }
+
+    PixelFormat GetFormat() const override { return format; }
+
+    std::string GetDescription() const override {
+        return spoutReceiver && spoutReceiver->IsConnected() ? spoutReceiver->GetSenderName() : std::string();
+    }
+};
+
+void RegisterWindowsFrameSources(FrameSourceRegistry& registry, const WindowsCaptureContext& context) {
+    const WindowsCaptureContext* shared = &context;
+    registry.Register("wgc", "Windows Graphics Capture of the target window", [shared]() {
+        return std::unique_ptr<IFrameSource>(new WgcFrameSource(*shared));
+    });
+    registry.Register("dxgi", "DXGI Desktop Duplication of the target window's area", [shared]() {
+        return std::unique_ptr<IFrameSource>(new DxgiFrameSource(*shared));
+    });
+    registry.Register("spout", "The first available Spout2 sender", [shared]() {
+        return std::unique_ptr<IFrameSource>(new SpoutFrameSource(*shared));
+    });
+}
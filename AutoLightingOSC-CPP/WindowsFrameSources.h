@@ -0,0 +1,23 @@
+// WindowsFrameSources.h
+#pragma once
+
+#include <Windows.h>
+#include <d3d11.h>
+#include <functional>
+#include "FrameSourceRegistry.h"
+
+class WindowManager;
+
+// What the Windows backends share. The device is used from the capturing thread, so its
+// immediate context has to be multithread protected when anything else uses it.
+struct WindowsCaptureContext {
+    WindowManager* windowManager = nullptr;
+    ID3D11Device* device = nullptr;
+    ID3D11DeviceContext* deviceContext = nullptr;
+    // Window the DXGI and Windows Graphics Capture backends capture, asked before every frame
+    std::function<HWND()> getWindow;
+};
+
+// Registers "wgc" (Windows Graphics Capture), "dxgi" (Desktop Duplication) and "spout" (Spout2).
+// The context must outlive every source created from the registry.
+void RegisterWindowsFrameSources(FrameSourceRegistry& registry, const WindowsCaptureContext& context);
@@ -41,8 +41,8 @@ static Bitmap CaptureScreenRegion(const RECT& captureArea) {
     BitBlt(hdcMemDC, 0, 0, width, height,
         hdcScreen, captureArea.left, captureArea.top, SRCCOPY);
 
-    // Fill our Bitmap
-    Bitmap result(width, height);
+    // Fill our Bitmap, 32-bit BI_RGB DIBs are BGRA
+    Bitmap result(width, height, PixelFormat::BGRA8);
     BITMAPINFO bmi = {};
     bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
     bmi.bmiHeader.biWidth = width;
@@ -51,7 +51,8 @@ static Bitmap CaptureScreenRegion(const RECT& captureArea) {
     bmi.bmiHeader.biBitCount = 32;
     bmi.bmiHeader.biCompression = BI_RGB;
 
-    GetDIBits(hdcMemDC, hbmCapture, 0, height,
+    // Pooled pixels are uninitialised, so a failed copy must not be returned as a frame
+    int copiedLines = GetDIBits(hdcMemDC, hbmCapture, 0, height,
         result.data.get(), &bmi, DIB_RGB_COLORS);
 
     // Clean up GDI objects
@@ -60,6 +61,9 @@ static Bitmap CaptureScreenRegion(const RECT& captureArea) {
     DeleteDC(hdcMemDC);
     ReleaseDC(nullptr, hdcScreen);
 
+    if (copiedLines != height) {
+        return Bitmap();
+    }
     return result;
 }
 
@@ -0,0 +1,283 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// bench_colorprocessor.cpp
+//
+// ColorProcessor stages on synthetic BGRA frames.
+// Frame benchmarks are indexed by frame height (720, 1080, 1440, 2160, 4320, all 16:9) and by
+// crop (0 = full frame, 1 = centred half-size crop). Per-color benchmarks are indexed by a
+// settings mask, see ApplySettingsMask. Every frame benchmark reports time/frame and the
+// frame bytes processed per second.
+//
+// With AUTOLIGHT_RECORDING set to a recording made with AutoLightOSCHeadless --record,
+// ReplayFramePipeline runs the same per-frame work on the recorded frames, in order and with the
+// crop each was captured with, so a real capture can be compared run to run.
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include "ColorProcessor.h"
+#include "FrameRecording.h"
+#include "PixelKernels.h"
+
+static const int SettingForceMaxBrightness = 1;
+static const int SettingSaturation = 2;
+static const int SettingWhiteMix = 4;
+static const int SettingCombinations = 8;
+
+// Synthetic frame of the given height, generated once and shared between benchmarks
+static const Bitmap& GetFrame(int height) {
+    static std::map<int, Bitmap> frames;
+
+    Bitmap& frame = frames[height];
+    if (!frame.IsValid()) {
+        int width = height * 16 / 9;
+        frame = Bitmap(width, height, PixelFormat::BGRA8);
+
+        // Gradients plus a little noise, so no channel is constant
+        uint32_t seed = 12345;
+        for (int y = 0; y < height; y++) {
+            uint8_t* row = frame.data.get() + static_cast<size_t>(y) * frame.stride;
+            for (int x = 0; x < width; x++) {
+                seed = seed * 1664525u + 1013904223u;
+                row[x * 4 + 0] = static_cast<uint8_t>(x * 255 / width);
+                row[x * 4 + 1] = static_cast<uint8_t>(y * 255 / height);
+                row[x * 4 + 2] = static_cast<uint8_t>(seed >> 24);
+                row[x * 4 + 3] = 255;
+            }
+        }
+    }
+    return frame;
+}
+
+static BitmapView GetInput(const benchmark::State& state) {
+    const Bitmap& frame = GetFrame(static_cast<int>(state.range(0)));
+    if (state.range(1) == 0) {
+        return frame;
+    }
+
+    PixelRect crop = { frame.width / 4, frame.height / 4, frame.width * 3 / 4, frame.height * 3 / 4 };
+    return frame.SubView(crop);
+}
+
+static void ApplySettingsMask(UserSettings& settings, int64_t mask) {
+    settings.forceMaxBrightness = (mask & SettingForceMaxBrightness) != 0;
+    settings.saturationValue = (mask & SettingSaturation) ? 50 : 0;
+    settings.whiteMixValue = (mask & SettingWhiteMix) ? 25 : 0;
+}
+
+static void SetFrameCounters(benchmark::State& state, const BitmapView& input) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * input.width * input.height * 4);
+    state.counters["time/frame"] = benchmark::Counter(static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.SetLabel(GetPixelKernelName());
+}
+
+static void FrameArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({ "height", "crop" });
+    for (int height : { 720, 1080, 1440, 2160, 4320 }) {
+        for (int crop = 0; crop <= 1; crop++) {
+            benchmark->Args({ height, crop });
+        }
+    }
+    benchmark->Unit(benchmark::kMicrosecond);
+}
+
+static void FrameSettingsArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({ "height", "crop", "settings" });
+    for (int height : { 720, 1080, 1440, 2160, 4320 }) {
+        for (int crop = 0; crop <= 1; crop++) {
+            for (int mask = 0; mask < SettingCombinations; mask++) {
+                benchmark->Args({ height, crop, mask });
+            }
+        }
+    }
+    benchmark->Unit(benchmark::kMicrosecond);
+}
+
+static void BM_DownscaleForProcessing(benchmark::State& state) {
+    UserSettings settings;
+    ColorProcessor processor(settings);
+    BitmapView input = GetInput(state);
+
+    for (auto _ : state) {
+        Bitmap downscaled = processor.DownscaleForProcessing(input);
+        benchmark::DoNotOptimize(downscaled.data.get());
+    }
+
+    SetFrameCounters(state, input);
+}
+BENCHMARK(BM_DownscaleForProcessing)->Apply(FrameArguments);
+
+// Full resolution average, the per-pixel channel sum kernel
+static void BM_GetAverageColor(benchmark::State& state) {
+    UserSettings settings;
+    ColorProcessor processor(settings);
+    BitmapView input = GetInput(state);
+
+    for (auto _ : state) {
+        ColorRGB color = processor.GetAverageColor(input);
+        benchmark::DoNotOptimize(color);
+    }
+
+    SetFrameCounters(state, input);
+}
+BENCHMARK(BM_GetAverageColor)->Apply(FrameArguments);
+
+// The two-step path the app used originally: downscale, then average the small copy
+static void BM_DownscaleThenAverage(benchmark::State& state) {
+    UserSettings settings;
+    ColorProcessor processor(settings);
+    BitmapView input = GetInput(state);
+
+    for (auto _ : state) {
+        ColorRGB color = processor.GetAverageColor(processor.DownscaleForProcessing(input));
+        benchmark::DoNotOptimize(color);
+    }
+
+    SetFrameCounters(state, input);
+}
+BENCHMARK(BM_DownscaleThenAverage)->Apply(FrameArguments);
+
+static void BM_GetDownscaledAverageColor(benchmark::State& state) {
+    UserSettings settings;
+    ColorProcessor processor(settings);
+    BitmapView input = GetInput(state);
+
+    for (auto _ : state) {
+        ColorRGB color = processor.GetDownscaledAverageColor(input);
+        benchmark::DoNotOptimize(color);
+    }
+
+    SetFrameCounters(state, input);
+}
+BENCHMARK(BM_GetDownscaledAverageColor)->Apply(FrameArguments);
+
+// Everything done per captured frame: average, then the color adjustments
+static void BM_FramePipeline(benchmark::State& state) {
+    UserSettings settings;
+    ApplySettingsMask(settings, state.range(2));
+    ColorProcessor processor(settings);
+    BitmapView input = GetInput(state);
+
+    for (auto _ : state) {
+        ColorRGB color = processor.ProcessColor(processor.GetDownscaledAverageColor(input));
+        benchmark::DoNotOptimize(color);
+    }
+
+    SetFrameCounters(state, input);
+}
+BENCHMARK(BM_FramePipeline)->Apply(FrameSettingsArguments);
+
+// Inputs cycle through a few colors so that no branch is always taken
+static const ColorRGB SampleColors[] = {
+    ColorRGB(0.8f, 0.2f, 0.1f),
+    ColorRGB(0.1f, 0.5f, 0.9f),
+    ColorRGB(0.3f, 0.3f, 0.3f),
+    ColorRGB(0.0f, 0.0f, 0.0f),
+    ColorRGB(0.05f, 0.9f, 0.4f),
+    ColorRGB(1.0f, 1.0f, 0.0f),
+    ColorRGB(0.6f, 0.1f, 0.7f),
+    ColorRGB(0.02f, 0.01f, 0.03f)
+};
+static const size_t SampleColorCount = sizeof(SampleColors) / sizeof(SampleColors[0]);
+
+static void BM_ProcessColor(benchmark::State& state) {
+    UserSettings settings;
+    ApplySettingsMask(settings, state.range(0));
+    ColorProcessor processor(settings);
+    size_t i = 0;
+
+    for (auto _ : state) {
+        ColorRGB color = processor.ProcessColor(SampleColors[i++ % SampleColorCount]);
+        benchmark::DoNotOptimize(color);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessColor)->ArgName("settings")->DenseRange(0, SettingCombinations - 1);
+
+static void BM_GetSmoothedColor(benchmark::State& state) {
+    UserSettings settings;
+    settings.enableSmoothing = state.range(0) != 0;
+    ColorProcessor processor(settings);
+    size_t i = 0;
+
+    for (auto _ : state) {
+        ColorRGB color = processor.GetSmoothedColor(1.0f / 60.0f, SampleColors[i++ % SampleColorCount]);
+        benchmark::DoNotOptimize(color);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetSmoothedColor)->ArgName("smoothing")->DenseRange(0, 1);
+
+static FrameRecordingReader recording;
+
+// BM_FramePipeline on the frames of a recording, one frame per iteration
+static void BM_ReplayFramePipeline(benchmark::State& state) {
+    UserSettings settings;
+    ApplySettingsMask(settings, state.range(0));
+    ColorProcessor processor(settings);
+    size_t frameCount = recording.GetFrameCount();
+    size_t i = 0;
+    int64_t bytes = 0;
+
+    for (auto _ : state) {
+        RecordedFrame frame = recording.GetFrame(i++ % frameCount);
+        const PixelRect& crop = frame.crop;
+        BitmapView input = crop.right > crop.left && crop.bottom > crop.top ? frame.view.SubView(crop) : frame.view;
+
+        ColorRGB color = processor.ProcessColor(processor.GetDownscaledAverageColor(input));
+        benchmark::DoNotOptimize(color);
+        bytes += static_cast<int64_t>(input.width) * input.height * 4;
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.counters["time/frame"] = benchmark::Counter(static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.SetLabel(GetPixelKernelName());
+}
+
+int main(int argc, char** argv) {
+    const char* recordingPath = std::getenv("AUTOLIGHT_RECORDING");
+    if (recordingPath && *recordingPath) {
+        std::string error;
+        if (!recording.Open(recordingPath, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        if (recording.GetFrameCount() > 0) {
+            benchmark::RegisterBenchmark("BM_ReplayFramePipeline", BM_ReplayFramePipeline)
+                ->ArgName("settings")->DenseRange(0, SettingCombinations - 1)->Unit(benchmark::kMicrosecond);
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
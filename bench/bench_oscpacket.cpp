@@ -0,0 +1,112 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// bench_oscpacket.cpp
+//
+// Cost of encoding one colour update (three float parameters), as separate messages and as a
+// bundle. OscPacketTemplate only patches the floats of pre-encoded packets; when oscpack is
+// available the same packets are also serialised through osc::OutboundPacketStream, which is
+// what every send used to do.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "OscPacketTemplate.h"
+
+#ifdef AUTOLIGHT_HAS_OSCPACK
+#include <osc/OscOutboundPacketStream.h>
+#endif
+
+static const float SampleValues[] = { -1.0f, -0.5f, 0.0f, 0.25f, 0.999f, 1.0f, 0.333f };
+static const size_t SampleValueCount = sizeof(SampleValues) / sizeof(SampleValues[0]);
+
+static void BM_OscPacketTemplate(benchmark::State& state) {
+    bool bundled = state.range(0) != 0;
+    OscPacketTemplate packets;
+    packets.Build({ "/avatar/parameters/AL_Red", "/avatar/parameters/AL_Green", "/avatar/parameters/AL_Blue" }, bundled);
+    size_t i = 0;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        packets.SetValue(0, SampleValues[i++ % SampleValueCount]);
+        packets.SetValue(1, SampleValues[i++ % SampleValueCount]);
+        packets.SetValue(2, SampleValues[i++ % SampleValueCount]);
+
+        for (size_t p = 0; p < packets.GetPacketCount(); p++) {
+            benchmark::DoNotOptimize(packets.GetPacketData(p));
+            bytes += packets.GetPacketSize(p);
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OscPacketTemplate)->ArgName("bundled")->DenseRange(0, 1);
+
+#ifdef AUTOLIGHT_HAS_OSCPACK
+
+// The previous send path: build the addresses, then serialise every message
+static void BM_OscOutboundPacketStream(benchmark::State& state) {
+    bool bundled = state.range(0) != 0;
+    std::string rParameter = "AL_Red";
+    std::string gParameter = "AL_Green";
+    std::string bParameter = "AL_Blue";
+    char buffer[1024];
+    size_t i = 0;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string rPath = "/avatar/parameters/" + rParameter;
+        std::string gPath = "/avatar/parameters/" + gParameter;
+        std::string bPath = "/avatar/parameters/" + bParameter;
+        float r = SampleValues[i++ % SampleValueCount];
+        float g = SampleValues[i++ % SampleValueCount];
+        float b = SampleValues[i++ % SampleValueCount];
+
+        osc::OutboundPacketStream p(buffer, sizeof(buffer));
+        if (bundled) {
+            p << osc::BeginBundleImmediate
+                << osc::BeginMessage(rPath.c_str()) << r << osc::EndMessage
+                << osc::BeginMessage(gPath.c_str()) << g << osc::EndMessage
+                << osc::BeginMessage(bPath.c_str()) << b << osc::EndMessage
+                << osc::EndBundle;
+            benchmark::DoNotOptimize(p.Data());
+            bytes += p.Size();
+        }
+        else {
+            const std::string* paths[] = { &rPath, &gPath, &bPath };
+            float values[] = { r, g, b };
+            for (int m = 0; m < 3; m++) {
+                p.Clear();
+                p << osc::BeginMessage(paths[m]->c_str()) << values[m] << osc::EndMessage;
+                benchmark::DoNotOptimize(p.Data());
+                bytes += p.Size();
+            }
+        }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OscOutboundPacketStream)->ArgName("bundled")->DenseRange(0, 1);
+
+#endif // AUTOLIGHT_HAS_OSCPACK
+
+BENCHMARK_MAIN();
@@ -0,0 +1,385 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+// latency_harness.cpp
+//
+// End-to-end latency from a colour change on screen to the OSC packet that carries it, without
+// VRChat or a capture backend. A synthetic frame source flips between red and blue at known
+// instants, the application's PipelineThread captures and processes it on its own schedule, and a
+// UDP receiver on loopback timestamps every AL_Red update. A flip's latency is the time until the
+// received value first crosses the midpoint between the two colours, reported as p50/p99/max per
+// combination of capture rate, smoothing and OSC rate, next to how late the pipeline's steps ran.
+//
+// Usage: latency_harness [--capture-fps 5,30,60] [--osc-rate 5,30,60] [--smoothing 0,0.5]
+//                        [--flips 10] [--async] [--bundles]
+// A smoothing value of 0 disables smoothing, anything else is the smoothing rate in seconds.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ColorProcessor.h"
+#include "OscManager.h"
+#include "PipelineThread.h"
+#include "UserSettings.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET ReceiverSocket;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int ReceiverSocket;
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static const int FrameWidth = 640;
+static const int FrameHeight = 360;
+static const char* const WatchedAddress = "/avatar/parameters/AL_Red";
+
+struct HarnessConfig {
+    int captureFps;
+    float smoothingRate; // 0 disables smoothing
+    int oscRate;
+};
+
+struct Arrival {
+    Clock::time_point time;
+    float value; // As sent, -1 to 1
+};
+
+// Receives on an ephemeral loopback port and records the AL_Red value of every datagram
+class OscReceiver {
+private:
+    ReceiverSocket socketHandle;
+    int port;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::mutex arrivalsMutex;
+    std::vector<Arrival> arrivals;
+
+    static size_t PaddedSize(size_t size) {
+        return (size + 4) & ~static_cast<size_t>(3);
+    }
+
+    // Finds the watched message anywhere in a message or bundle and reads its first float
+    static bool FindValue(const char* data, size_t size, float& value) {
+        size_t addressLength = std::strlen(WatchedAddress);
+        for (size_t i = 0; i + addressLength < size; i += 4) {
+            if (std::memcmp(data + i, WatchedAddress, addressLength + 1) != 0) {
+                continue;
+            }
+
+            size_t typeTags = i + PaddedSize(addressLength);
+            if (typeTags + 2 > size || data[typeTags] != ',' || data[typeTags + 1] != 'f') {
+                return false;
+            }
+
+            size_t argument = typeTags + PaddedSize(std::strlen(data + typeTags));
+            if (argument + 4 > size) {
+                return false;
+            }
+
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data + argument);
+            uint32_t bits = (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+                (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+            std::memcpy(&value, &bits, sizeof(value));
+            return true;
+        }
+        return false;
+    }
+
+    void ReceiveLoop() {
+        char buffer[2048];
+        while (running) {
+            int received = static_cast<int>(recv(socketHandle, buffer, sizeof(buffer) - 1, 0));
+            Clock::time_point now = Clock::now();
+            if (received <= 0) {
+                continue; // Timeout, checks running again
+            }
+            buffer[received] = '\0';
+
+            float value;
+            if (FindValue(buffer, static_cast<size_t>(received), value)) {
+                std::lock_guard<std::mutex> lock(arrivalsMutex);
+                arrivals.push_back({ now, value });
+            }
+        }
+    }
+
+public:
+    OscReceiver() : port(0), running(false) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+        socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        if (bind(socketHandle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            std::fprintf(stderr, "Error binding the loopback receiver\n");
+            std::exit(1);
+        }
+
+        socklen_t addressSize = sizeof(address);
+        getsockname(socketHandle, reinterpret_cast<sockaddr*>(&address), &addressSize);
+        port = ntohs(address.sin_port);
+
+        // Short timeout so the thread notices Stop
+#ifdef _WIN32
+        DWORD timeout = 50;
+#else
+        timeval timeout = { 0, 50000 };
+#endif
+        setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+        running = true;
+        thread = std::thread(&OscReceiver::ReceiveLoop, this);
+    }
+
+    ~OscReceiver() {
+        running = false;
+        thread.join();
+#ifdef _WIN32
+        closesocket(socketHandle);
+        WSACleanup();
+#else
+        close(socketHandle);
+#endif
+    }
+
+    int GetPort() const { return port; }
+
+    std::vector<Arrival> TakeArrivals() {
+        std::lock_guard<std::mutex> lock(arrivalsMutex);
+        std::vector<Arrival> taken;
+        taken.swap(arrivals);
+        return taken;
+    }
+};
+
+static Bitmap MakeSolidFrame(uint8_t r, uint8_t g, uint8_t b) {
+    Bitmap frame(FrameWidth, FrameHeight, PixelFormat::BGRA8);
+    for (int y = 0; y < FrameHeight; y++) {
+        uint8_t* row = frame.data.get() + static_cast<size_t>(y) * frame.stride;
+        for (int x = 0; x < FrameWidth; x++) {
+            row[x * 4 + 0] = b;
+            row[x * 4 + 1] = g;
+            row[x * 4 + 2] = r;
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return frame;
+}
+
+// AL_Red as sent for a solid frame, after the colour processing the settings ask for
+static float GetSentRed(UserSettings& settings, const Bitmap& frame) {
+    ColorProcessor processor(settings);
+    ColorRGB color = processor.ProcessColor(processor.GetDownscaledAverageColor(frame));
+    return color.r * 2.0f - 1.0f;
+}
+
+static double Percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+static std::vector<int> ParseIntList(const char* text) {
+    std::vector<int> values;
+    for (const char* p = text; *p; ) {
+        values.push_back(std::atoi(p));
+        p = std::strchr(p, ',');
+        if (!p) break;
+        p++;
+    }
+    return values;
+}
+
+static std::vector<float> ParseFloatList(const char* text) {
+    std::vector<float> values;
+    for (const char* p = text; *p; ) {
+        values.push_back(static_cast<float>(std::atof(p)));
+        p = std::strchr(p, ',');
+        if (!p) break;
+        p++;
+    }
+    return values;
+}
+
+// Runs flipCount flips through a fresh pipeline and returns each one's latency in milliseconds.
+// Flips that never reached the receiver are counted in missed.
+static std::vector<double> RunConfig(const HarnessConfig& config, int flipCount, bool async, bool bundles,
+    OscReceiver& receiver, std::mt19937& random, int& missed, double& schedulingP99Us) {
+    UserSettings settings;
+    settings.captureFps = config.captureFps;
+    settings.oscRate = config.oscRate;
+    settings.enableSmoothing = config.smoothingRate > 0.0f;
+    if (settings.enableSmoothing) {
+        settings.smoothingRateValue = config.smoothingRate;
+    }
+    settings.oscAsync = async;
+    settings.oscUseBundles = bundles;
+    settings.oscPort = receiver.GetPort();
+
+    Bitmap frames[2] = { MakeSolidFrame(255, 0, 0), MakeSolidFrame(0, 0, 255) };
+    float sentRed[2] = { GetSentRed(settings, frames[0]), GetSentRed(settings, frames[1]) };
+    float midpoint = (sentRed[0] + sentRed[1]) * 0.5f;
+
+    OscManager oscManager("127.0.0.1", settings.oscPort);
+    oscManager.SetOscRate(settings.oscRate);
+    oscManager.SetUseBundles(settings.oscUseBundles);
+
+    // The capture step reads whichever frame is shown, like a capture backend would
+    std::atomic<int> shown(0);
+    PipelineThread pipeline(oscManager);
+    pipeline.Start(settings, [&](CapturedFrame& frame) {
+        frame.bitmap = frames[shown];
+        frame.timestamp = Clock::now();
+        return PipelineThread::CaptureResult::Captured;
+    });
+
+    // Long enough between flips for the output to settle on the new colour, with jitter so
+    // flips land at every phase of the capture and OSC steps
+    auto settleTime = std::chrono::milliseconds(std::max(800, static_cast<int>(config.smoothingRate * 5000.0f)));
+    std::uniform_int_distribution<int> jitterMs(0, 200);
+
+    std::vector<Clock::time_point> flipTimes;
+    Clock::time_point nextFlip = Clock::now() + settleTime;
+    for (int flip = 0; flip < flipCount; flip++) {
+        std::this_thread::sleep_until(nextFlip);
+        flipTimes.push_back(Clock::now());
+        shown = 1 - shown;
+        nextFlip = flipTimes.back() + settleTime + std::chrono::milliseconds(jitterMs(random));
+    }
+    std::this_thread::sleep_until(nextFlip);
+    pipeline.Stop();
+
+    // Worst p99 lateness of the pipeline's steps
+    pipeline.UpdateOutput();
+    const PipelineThread::Output& output = pipeline.GetOutput();
+    schedulingP99Us = std::max({ output.captureStats.p99LatenessUs, output.smoothingStats.p99LatenessUs, output.oscStats.p99LatenessUs });
+
+    // Give the last packets time to arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::vector<Arrival> arrivals = receiver.TakeArrivals();
+
+    std::vector<double> latencies;
+    missed = 0;
+    for (size_t flip = 0; flip < flipTimes.size(); flip++) {
+        // The first flip goes to blue, then they alternate
+        float target = sentRed[(flip + 1) % 2];
+        float start = sentRed[flip % 2];
+        Clock::time_point end = flip + 1 < flipTimes.size() ? flipTimes[flip + 1] : Clock::time_point::max();
+
+        auto crossing = std::find_if(arrivals.begin(), arrivals.end(), [&](const Arrival& arrival) {
+            if (arrival.time < flipTimes[flip] || arrival.time >= end) {
+                return false;
+            }
+            return target < start ? arrival.value <= midpoint : arrival.value >= midpoint;
+        });
+
+        if (crossing == arrivals.end()) {
+            missed++;
+            continue;
+        }
+        latencies.push_back(std::chrono::duration<double, std::milli>(crossing->time - flipTimes[flip]).count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    return latencies;
+}
+
+int main(int argc, char** argv) {
+    std::vector<int> captureRates = { 5, 30, 60 };
+    std::vector<int> oscRates = { 5, 30, 60 };
+    std::vector<float> smoothingRates = { 0.0f, 0.5f };
+    int flipCount = 10;
+    bool async = false;
+    bool bundles = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--capture-fps" && hasValue) captureRates = ParseIntList(argv[++i]);
+        else if (arg == "--osc-rate" && hasValue) oscRates = ParseIntList(argv[++i]);
+        else if (arg == "--smoothing" && hasValue) smoothingRates = ParseFloatList(argv[++i]);
+        else if (arg == "--flips" && hasValue) flipCount = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--async") async = true;
+        else if (arg == "--bundles") bundles = true;
+        else {
+            std::fprintf(stderr, "Usage: %s [--capture-fps 5,30,60] [--osc-rate 5,30,60] [--smoothing 0,0.5] "
+                "[--flips 10] [--async] [--bundles]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    OscReceiver receiver;
+    std::mt19937 random(12345);
+
+    std::printf("%8s %10s %8s %6s %7s %9s %9s %9s %13s\n",
+        "capture", "smoothing", "osc", "flips", "missed", "p50 ms", "p99 ms", "max ms", "late p99 us");
+
+    for (int captureFps : captureRates) {
+        for (float smoothingRate : smoothingRates) {
+            for (int oscRate : oscRates) {
+                HarnessConfig config = { std::max(1, captureFps), std::max(0.0f, smoothingRate), std::max(1, oscRate) };
+                int missed = 0;
+                double schedulingP99Us = 0.0;
+                std::vector<double> latencies = RunConfig(config, flipCount, async, bundles, receiver, random, missed, schedulingP99Us);
+
+                char smoothing[16];
+                if (config.smoothingRate > 0.0f) {
+                    std::snprintf(smoothing, sizeof(smoothing), "%.2fs", config.smoothingRate);
+                }
+                else {
+                    std::snprintf(smoothing, sizeof(smoothing), "off");
+                }
+
+                std::printf("%8d %10s %8d %6d %7d %9.1f %9.1f %9.1f %13.0f\n",
+                    config.captureFps, smoothing, config.oscRate, flipCount, missed,
+                    Percentile(latencies, 0.50), Percentile(latencies, 0.99),
+                    latencies.empty() ? 0.0 : latencies.back(), schedulingP99Us);
+                std::fflush(stdout);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+// Check.h
+#pragma once
+
+#include <cstdio>
+
+// The tests are plain executables run by CTest: a failed CHECK prints where and what failed and
+// is counted, and main returns CheckResult() so that any failure fails the test.
+static int failedChecks = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            failedChecks++; \
+        } \
+    } while (0)
+
+// Same, with a printf-style description of the case that failed
+#define CHECK_MESSAGE(condition, ...) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed: ", __FILE__, __LINE__, #condition); \
+            std::fprintf(stderr, __VA_ARGS__); \
+            std::fprintf(stderr, "\n"); \
+            failedChecks++; \
+        } \
+    } while (0)
+
+static inline int CheckResult() {
+    if (failedChecks > 0) {
+        std::fprintf(stderr, "%d check(s) failed\n", failedChecks);
+        return 1;
+    }
+    return 0;
+}
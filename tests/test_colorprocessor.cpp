@@ -0,0 +1,101 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_colorprocessor.cpp
+//
+// GetDownscaledAverageColor has to return exactly what the two-step path it replaced returns,
+// GetAverageColor(DownscaleForProcessing(image)), bit for bit: for frames below and above
+// MaxProcessingSize, odd sizes, crops that are strided views into a larger frame, and both
+// pixel formats.
+
+#include <cstdint>
+#include <cstring>
+#include "Check.h"
+#include "ColorProcessor.h"
+
+// Gradients plus noise, so no channel is constant and every bilinear weight matters
+static Bitmap MakeFrame(int width, int height, PixelFormat format, uint32_t seed) {
+    Bitmap frame(width, height, format);
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = frame.data.get() + static_cast<size_t>(y) * frame.stride;
+        for (int x = 0; x < width; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            row[x * 4 + 0] = static_cast<uint8_t>(x * 255 / width);
+            row[x * 4 + 1] = static_cast<uint8_t>(seed >> 24);
+            row[x * 4 + 2] = static_cast<uint8_t>(y * 255 / height);
+            row[x * 4 + 3] = 255;
+        }
+    }
+    return frame;
+}
+
+static bool SameBits(const ColorRGB& a, const ColorRGB& b) {
+    return std::memcmp(&a.r, &b.r, sizeof(float)) == 0 &&
+        std::memcmp(&a.g, &b.g, sizeof(float)) == 0 &&
+        std::memcmp(&a.b, &b.b, sizeof(float)) == 0;
+}
+
+static void CheckSameAverage(ColorProcessor& processor, const BitmapView& image, const char* what) {
+    ColorRGB expected = processor.GetAverageColor(processor.DownscaleForProcessing(image));
+    ColorRGB fused = processor.GetDownscaledAverageColor(image);
+    CHECK_MESSAGE(SameBits(expected, fused), "%s %dx%d (stride %d, %s): expected %.9g %.9g %.9g, got %.9g %.9g %.9g",
+        what, image.width, image.height, image.stride, image.format == PixelFormat::RGBA8 ? "RGBA8" : "BGRA8",
+        expected.r, expected.g, expected.b, fused.r, fused.g, fused.b);
+}
+
+int main() {
+    UserSettings settings;
+    ColorProcessor processor(settings);
+
+    const int sizes[][2] = {
+        { 1, 1 }, { 3, 5 }, { 99, 100 }, { 100, 100 }, { 101, 100 }, { 100, 101 }, { 101, 101 },
+        { 199, 73 }, { 641, 359 }, { 1279, 721 }, { 1920, 1080 }, { 1921, 1081 }, { 7, 1083 }, { 2561, 3 }
+    };
+
+    uint32_t seed = 1;
+    for (PixelFormat format : { PixelFormat::BGRA8, PixelFormat::RGBA8 }) {
+        for (const auto& size : sizes) {
+            Bitmap frame = MakeFrame(size[0], size[1], format, seed++);
+            CheckSameAverage(processor, frame, "frame");
+
+            // Crops keep the stride of the whole frame, with odd offsets and sizes
+            const PixelRect crops[] = {
+                { size[0] / 4, size[1] / 4, size[0] * 3 / 4 + 1, size[1] * 3 / 4 + 1 },
+                { 1, 1, size[0], size[1] },
+                { size[0] / 3, 0, size[0] - 1, size[1] / 2 + 1 },
+                { 0, size[1] / 5, size[0] / 2 + 1, size[1] }
+            };
+            for (const PixelRect& crop : crops) {
+                BitmapView view = frame.SubView(crop);
+                if (view.IsValid()) {
+                    CheckSameAverage(processor, view, "crop of");
+                }
+            }
+        }
+    }
+
+    // Nothing to average
+    ColorRGB empty = processor.GetDownscaledAverageColor(BitmapView());
+    CHECK(empty.r == 0.0f && empty.g == 0.0f && empty.b == 0.0f);
+
+    return CheckResult();
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_framepool.cpp
+//
+// Once the pool has warmed up, a steady stream of same-sized frames has to make no heap
+// allocations at all: not for the pixels, not for the shared_ptr control blocks. The global
+// operator new and delete are replaced with counting versions, and a capture, process and
+// release cycle is run with the test pattern source for many frames after a warm-up.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "Check.h"
+#include "ColorProcessor.h"
+#include "FramePool.h"
+#include "TestPatternSource.h"
+
+static std::atomic<uint64_t> heapAllocations{ 0 };
+
+static void* CountedAllocate(size_t size) {
+    heapAllocations++;
+    void* block = std::malloc(size == 0 ? 1 : size);
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+static void* CountedAllocateAligned(size_t size, std::align_val_t alignment) {
+    heapAllocations++;
+#ifdef _WIN32
+    void* block = _aligned_malloc(size == 0 ? 1 : size, static_cast<size_t>(alignment));
+#else
+    void* block = nullptr;
+    if (posix_memalign(&block, static_cast<size_t>(alignment), size == 0 ? 1 : size) != 0) {
+        block = nullptr;
+    }
+#endif
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+static void FreeAligned(void* block) {
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return CountedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return CountedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return CountedAllocateAligned(size, alignment); }
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+void operator delete[](void* block, size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { FreeAligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { FreeAligned(block); }
+void operator delete(void* block, size_t, std::align_val_t) noexcept { FreeAligned(block); }
+void operator delete[](void* block, size_t, std::align_val_t) noexcept { FreeAligned(block); }
+
+// Captures, processes and releases frameCount frames, keeping up to framesInFlight of them alive
+// at once like the pipeline and the preview do. Returns the heap allocations it made.
+static uint64_t RunFrames(IFrameSource& source, ColorProcessor& processor, int frameCount, int framesInFlight) {
+    const int MaxFramesInFlight = 3;
+    CapturedFrame frames[MaxFramesInFlight];
+    float sum = 0.0f;
+
+    uint64_t before = heapAllocations.load();
+    for (int i = 0; i < frameCount; i++) {
+        CapturedFrame& frame = frames[i % framesInFlight];
+        source.ReleaseFrame(frame);
+        if (source.AcquireFrame(frame) != CaptureResult::Captured) {
+            continue;
+        }
+
+        // Both processing paths, the two-step one allocates its downscaled copy from the pool too
+        sum += processor.GetDownscaledAverageColor(frame.bitmap).r;
+        sum += processor.GetAverageColor(processor.DownscaleForProcessing(frame.bitmap)).g;
+
+        // A crop shares the frame's buffer
+        Bitmap held = frame.bitmap;
+        sum += processor.GetDownscaledAverageColor(held.SubView({ 10, 10, 200, 100 })).b;
+    }
+    for (int i = 0; i < framesInFlight; i++) {
+        source.ReleaseFrame(frames[i]);
+    }
+    uint64_t allocations = heapAllocations.load() - before;
+
+    CHECK(sum >= 0.0f);
+    return allocations;
+}
+
+int main() {
+    const int WarmUpFrames = 16;
+    const int SteadyFrames = 500;
+
+    UserSettings settings;
+    ColorProcessor processor(settings);
+    TestPatternSource source(1.0, 1280, 720);
+    std::string error;
+    CHECK(source.Open(error));
+
+    for (int framesInFlight = 1; framesInFlight <= 3; framesInFlight++) {
+        RunFrames(source, processor, WarmUpFrames, framesInFlight);
+
+        FramePool::Stats before = FramePool::Instance().GetStats();
+        uint64_t allocations = RunFrames(source, processor, SteadyFrames, framesInFlight);
+        FramePool::Stats after = FramePool::Instance().GetStats();
+
+        CHECK_MESSAGE(allocations == 0, "%llu heap allocations in %d frames with %d in flight",
+            static_cast<unsigned long long>(allocations), SteadyFrames, framesInFlight);
+        CHECK(after.heapAllocations == before.heapAllocations);
+        CHECK(after.reuses > before.reuses);
+    }
+
+    // The counters do see allocations, and Trim hands the buffers back
+    uint64_t before = heapAllocations.load();
+    Bitmap odd(333, 77);
+    CHECK(heapAllocations.load() > before);
+    odd = Bitmap();
+    FramePool::Instance().Trim();
+    CHECK(FramePool::Instance().GetStats().cachedBuffers == 0);
+
+    source.Close();
+    return CheckResult();
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_framerecording.cpp
+//
+// Frames written by FrameRecorder read back unchanged, through the index of a closed recording
+// and by scanning one that was never closed. A corrupt frame header, in either case, must never
+// produce a frame that reaches outside the file: the reader falls back to the frames it can
+// verify, and every frame it hands out is averaged to prove its pixels are readable. Where a
+// file size limit can be set, a recording that cannot grow stops cleanly and is still closed
+// with its index.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "ColorProcessor.h"
+#include "FrameRecording.h"
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+static const char* const RecordingPath = "test_framerecording.alf";
+static const char* const CorruptPath = "test_framerecording_corrupt.alf";
+static const char* const FullPath = "test_framerecording_full.alf";
+static const int FrameCount = 12;
+
+static std::vector<char> ReadFile(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const char* path, const std::vector<char>& data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+template <typename T>
+static void Patch(std::vector<char>& data, size_t offset, T value) {
+    std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+// Frame i is filled with bytes derived from i, in a size and format that change every frame
+static Bitmap MakeFrame(int i) {
+    Bitmap frame(31 + i * 7, 17 + i * 3, i % 2 == 0 ? PixelFormat::BGRA8 : PixelFormat::RGBA8);
+    for (int y = 0; y < frame.height; y++) {
+        uint8_t* row = frame.data.get() + static_cast<size_t>(y) * frame.stride;
+        for (int x = 0; x < frame.width * 4; x++) {
+            row[x] = static_cast<uint8_t>(x * 3 + y * 5 + i * 11);
+        }
+    }
+    return frame;
+}
+
+// Opens path and checks every frame the reader hands out: readable, and equal to what was recorded
+static size_t CheckReadable(const char* path, const char* what) {
+    FrameRecordingReader reader;
+    std::string error;
+    CHECK_MESSAGE(reader.Open(path, error), "%s: %s", what, error.c_str());
+
+    UserSettings settings;
+    ColorProcessor processor(settings);
+    for (size_t i = 0; i < reader.GetFrameCount(); i++) {
+        RecordedFrame recorded = reader.GetFrame(i);
+        Bitmap expected = MakeFrame(static_cast<int>(i));
+        CHECK_MESSAGE(recorded.view.width == expected.width && recorded.view.height == expected.height &&
+            recorded.view.format == expected.format, "%s: frame %zu", what, i);
+        if (recorded.view.width != expected.width || recorded.view.height != expected.height) {
+            continue;
+        }
+
+        for (int y = 0; y < expected.height; y++) {
+            CHECK(std::memcmp(recorded.view.data + static_cast<size_t>(y) * recorded.view.stride,
+                expected.data.get() + static_cast<size_t>(y) * expected.stride, static_cast<size_t>(expected.width) * 4) == 0);
+        }
+        CHECK(recorded.crop.left == static_cast<int>(i) && recorded.crop.right == static_cast<int>(i) + 10);
+
+        Bitmap bitmap = reader.GetBitmap(i);
+        ColorRGB color = processor.GetAverageColor(bitmap);
+        CHECK(color.r >= 0.0f && color.r <= 1.0f);
+    }
+    return reader.GetFrameCount();
+}
+
+#ifndef _WIN32
+// Same as a full disk for the recorder: growing the file past the limit fails with EFBIG
+static void CheckFailedGrow() {
+    const rlim_t limit = 80 * 1024 * 1024;
+    rlimit previous;
+    CHECK(getrlimit(RLIMIT_FSIZE, &previous) == 0);
+    if (previous.rlim_max != RLIM_INFINITY && previous.rlim_max < limit) {
+        std::printf("File size limit already below %llu bytes, skipping the failed grow\n", static_cast<unsigned long long>(limit));
+        return;
+    }
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit lowered = previous;
+    lowered.rlim_cur = limit;
+    CHECK(setrlimit(RLIMIT_FSIZE, &lowered) == 0);
+
+    // Eight of these fit the initial capacity, the ninth needs more than the limit allows
+    Bitmap frame(1920, 1080, PixelFormat::BGRA8);
+    std::memset(frame.data.get(), 0x80, static_cast<size_t>(frame.stride) * frame.height);
+    auto start = std::chrono::steady_clock::now();
+
+    FrameRecorder recorder;
+    CHECK(recorder.Open(FullPath));
+    int appended = 0;
+    while (appended < 20 && recorder.Append(frame, start + std::chrono::milliseconds(appended * 16), { 0, 0, 0, 0 })) {
+        appended++;
+    }
+    CHECK_MESSAGE(appended == 8, "%d frames appended before the file could not grow", appended);
+    CHECK(!recorder.IsOpen());
+    CHECK(recorder.GetFrameCount() == static_cast<uint64_t>(appended));
+    CHECK(!recorder.Append(frame, start, { 0, 0, 0, 0 }));
+    recorder.Close();
+
+    CHECK(setrlimit(RLIMIT_FSIZE, &previous) == 0);
+    std::signal(SIGXFSZ, SIG_DFL);
+
+    // Closed with its index and trimmed to it
+    RecordingFileHeader header = {};
+    std::ifstream in(FullPath, std::ios::binary | std::ios::ate);
+    std::streamoff fileSize = in.tellg();
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    CHECK(header.frameCount == static_cast<uint64_t>(appended) && header.indexOffset > 0);
+    CHECK(static_cast<uint64_t>(fileSize) == header.indexOffset + appended * sizeof(uint64_t));
+    in.close();
+
+    FrameRecordingReader reader;
+    std::string error;
+    CHECK_MESSAGE(reader.Open(FullPath, error), "%s", error.c_str());
+    CHECK(reader.GetFrameCount() == static_cast<size_t>(appended));
+    reader.Close();
+    std::remove(FullPath);
+}
+#endif
+
+int main() {
+    auto start = std::chrono::steady_clock::now();
+    {
+        FrameRecorder recorder;
+        CHECK(recorder.Open(RecordingPath));
+        for (int i = 0; i < FrameCount; i++) {
+            Bitmap frame = MakeFrame(i);
+            // A view into a wider frame, so the recorder has to pack the rows
+            Bitmap wide(frame.width + 5, frame.height, frame.format);
+            for (int y = 0; y < frame.height; y++) {
+                std::memcpy(wide.data.get() + static_cast<size_t>(y) * wide.stride,
+                    frame.data.get() + static_cast<size_t>(y) * frame.stride, static_cast<size_t>(frame.width) * 4);
+            }
+            BitmapView view(wide.data.get(), frame.width, frame.height, wide.stride, frame.format);
+            CHECK(recorder.Append(view, start + std::chrono::milliseconds(i * 33), { i, 0, i + 10, 5 }));
+        }
+        CHECK(recorder.GetFrameCount() == FrameCount);
+        recorder.Close();
+    }
+
+    CHECK(CheckReadable(RecordingPath, "closed recording") == FrameCount);
+
+    std::vector<char> original = ReadFile(RecordingPath);
+    RecordingFileHeader fileHeader;
+    CHECK(original.size() > sizeof(fileHeader));
+    std::memcpy(&fileHeader, original.data(), sizeof(fileHeader));
+    CHECK(fileHeader.indexOffset > 0 && fileHeader.frameCount == FrameCount);
+
+    {
+        FrameRecordingReader reader;
+        std::string error;
+        CHECK(reader.Open(RecordingPath, error));
+        CHECK(reader.FindFrame(0) == 0);
+        CHECK(reader.FindFrame(5 * 33000 + 1) == 5);
+        CHECK(reader.FindFrame(1000000000) == FrameCount - 1);
+        CHECK(reader.GetDurationUs() == (FrameCount - 1) * 33000);
+    }
+
+    uint64_t frameOffsets[FrameCount];
+    std::memcpy(frameOffsets, original.data() + fileHeader.indexOffset, sizeof(frameOffsets));
+
+    // A recording that was never closed: no index, and the capacity it had grown to past the frames
+    std::vector<char> unclosed(original.begin(), original.begin() + static_cast<ptrdiff_t>(fileHeader.indexOffset));
+    unclosed.resize(unclosed.size() + 4096, 0);
+    Patch<uint64_t>(unclosed, offsetof(RecordingFileHeader, indexOffset), 0);
+    WriteFile(CorruptPath, unclosed);
+    CHECK(CheckReadable(CorruptPath, "unclosed recording") == FrameCount);
+
+    // Every field of frame 9's header broken in turn, with the index and without it
+    struct Corruption {
+        const char* what;
+        size_t field;
+        int64_t value;
+        size_t size;
+    };
+    const Corruption corruptions[] = {
+        { "height", offsetof(RecordingFrameHeader, height), 100000, sizeof(int32_t) },
+        { "negative height", offsetof(RecordingFrameHeader, height), -5, sizeof(int32_t) },
+        { "width", offsetof(RecordingFrameHeader, width), 0x7FFFFFFF, sizeof(int32_t) },
+        { "format", offsetof(RecordingFrameHeader, format), 7, sizeof(uint32_t) },
+        { "pixel bytes", offsetof(RecordingFrameHeader, pixelBytes), 0x7FFFFFFFFFFFFFFF, sizeof(uint64_t) },
+        { "magic", offsetof(RecordingFrameHeader, magic), 0, sizeof(uint32_t) },
+    };
+    for (const Corruption& corruption : corruptions) {
+        for (bool indexed : { true, false }) {
+            std::vector<char> corrupt = indexed ? original : unclosed;
+            size_t offset = static_cast<size_t>(frameOffsets[9]) + corruption.field;
+            if (corruption.size == sizeof(int32_t)) {
+                Patch<int32_t>(corrupt, offset, static_cast<int32_t>(corruption.value));
+            }
+            else {
+                Patch<int64_t>(corrupt, offset, corruption.value);
+            }
+            WriteFile(CorruptPath, corrupt);
+
+            // The frames before the broken one are still there, and nothing past the file is
+            size_t frames = CheckReadable(CorruptPath, corruption.what);
+            CHECK_MESSAGE(frames == 9, "%s (%s): %zu frames", corruption.what, indexed ? "indexed" : "scanned", frames);
+        }
+    }
+
+    // An index pointing past itself is not trusted either
+    std::vector<char> badIndex = original;
+    Patch<uint64_t>(badIndex, static_cast<size_t>(fileHeader.indexOffset) + 3 * sizeof(uint64_t), fileHeader.indexOffset + 64);
+    WriteFile(CorruptPath, badIndex);
+    CHECK(CheckReadable(CorruptPath, "index past itself") == FrameCount);
+
+    std::remove(RecordingPath);
+    std::remove(CorruptPath);
+
+#ifndef _WIN32
+    CheckFailedGrow();
+#endif
+    return CheckResult();
+}
@@ -0,0 +1,273 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_oscmanager.cpp
+//
+// Bundle mode with several destinations: every destination has to put the same parameters in
+// the same bundles even when they name the colour parameters differently, so that a change
+// resends the same bundle everywhere and no bundle exceeds the MTU for any of them. Two
+// receivers on loopback ports take the place of VRChat and an extra destination with much longer
+// parameter names, and enough zone parameters are registered to need several bundles.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "OscManager.h"
+#include "UserSettings.h"
+#include "ValueQuantizer.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET ReceiverSocket;
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int ReceiverSocket;
+#endif
+
+static const char* const AddressPrefix = "/avatar/parameters/";
+static const int Mtu = 576;
+static const size_t ZoneCount = 48;
+
+// One parameter of a received message, by name
+struct ReceivedMessage {
+    std::string name;
+    float value;
+};
+
+// Every datagram that arrives on an ephemeral loopback port, parsed into its messages
+class LoopbackReceiver {
+private:
+    ReceiverSocket socketHandle;
+    int port;
+
+    static size_t PaddedSize(size_t size) {
+        return (size + 4) & ~static_cast<size_t>(3);
+    }
+
+    static uint32_t ReadInt32(const char* data) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+            (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    }
+
+    // A single-float message, false if it is anything else
+    static bool ParseMessage(const char* data, size_t size, ReceivedMessage& message) {
+        size_t addressLength = strnlen(data, size);
+        size_t typeTags = PaddedSize(addressLength);
+        if (typeTags + 8 != size || std::strncmp(data, AddressPrefix, std::strlen(AddressPrefix)) != 0 ||
+            std::memcmp(data + typeTags, ",f\0\0", 4) != 0) {
+            return false;
+        }
+
+        message.name.assign(data + std::strlen(AddressPrefix), addressLength - std::strlen(AddressPrefix));
+        uint32_t bits = ReadInt32(data + typeTags + 4);
+        std::memcpy(&message.value, &bits, sizeof(message.value));
+        return true;
+    }
+
+    // The messages of a bundle, or of a single message, false if it is malformed
+    static bool ParsePacket(const char* data, size_t size, std::vector<ReceivedMessage>& messages) {
+        ReceivedMessage message;
+        if (size < 16 || std::memcmp(data, "#bundle\0", 8) != 0) {
+            if (!ParseMessage(data, size, message)) {
+                return false;
+            }
+            messages.push_back(message);
+            return true;
+        }
+
+        for (size_t offset = 16; offset < size;) {
+            if (offset + 4 > size) {
+                return false;
+            }
+            size_t elementSize = ReadInt32(data + offset);
+            offset += 4;
+            if (offset + elementSize > size || !ParseMessage(data + offset, elementSize, message)) {
+                return false;
+            }
+            messages.push_back(message);
+            offset += elementSize;
+        }
+        return true;
+    }
+
+public:
+    LoopbackReceiver() : port(0) {
+        socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        CHECK(bind(socketHandle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+
+        socklen_t addressSize = sizeof(address);
+        getsockname(socketHandle, reinterpret_cast<sockaddr*>(&address), &addressSize);
+        port = ntohs(address.sin_port);
+
+        // Everything sent has arrived once nothing came for this long
+#ifdef _WIN32
+        DWORD timeout = 200;
+#else
+        timeval timeout = { 0, 200000 };
+#endif
+        setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    }
+
+    ~LoopbackReceiver() {
+#ifdef _WIN32
+        closesocket(socketHandle);
+#else
+        close(socketHandle);
+#endif
+    }
+
+    int GetPort() const { return port; }
+
+    // The messages of every datagram received until the socket goes quiet, one list per datagram
+    std::vector<std::vector<ReceivedMessage>> Receive() {
+        std::vector<std::vector<ReceivedMessage>> packets;
+        char buffer[65536];
+        for (;;) {
+            int received = static_cast<int>(recv(socketHandle, buffer, sizeof(buffer), 0));
+            if (received <= 0) {
+                return packets;
+            }
+
+            CHECK_MESSAGE(received <= Mtu - 28, "%d byte datagram for a %d byte MTU", received, Mtu);
+            packets.emplace_back();
+            CHECK(ParsePacket(buffer, static_cast<size_t>(received), packets.back()));
+        }
+    }
+};
+
+// Parameter IDs of every received datagram, names looked up in the destination's own table
+static std::vector<std::vector<int>> ToParameterIds(const std::vector<std::vector<ReceivedMessage>>& packets,
+    const std::map<std::string, int>& names, const std::vector<float>& expectedValues) {
+    std::vector<std::vector<int>> ids;
+    for (const std::vector<ReceivedMessage>& packet : packets) {
+        ids.emplace_back();
+        for (const ReceivedMessage& message : packet) {
+            auto name = names.find(message.name);
+            CHECK_MESSAGE(name != names.end(), "unknown parameter \"%s\"", message.name.c_str());
+            if (name == names.end()) {
+                continue;
+            }
+            ids.back().push_back(name->second);
+            CHECK_MESSAGE(message.value == expectedValues[name->second], "%s is %g, expected %g",
+                message.name.c_str(), message.value, expectedValues[name->second]);
+        }
+    }
+    return ids;
+}
+
+int main() {
+#ifdef _WIN32
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+    {
+        LoopbackReceiver vrchat;
+        LoopbackReceiver extra;
+
+        OscDestination destination;
+        destination.port = extra.GetPort();
+        destination.rParameter = "Extra_Destination_Red_Channel_With_A_Much_Longer_Name";
+        destination.gParameter = "Extra_Destination_Green_Channel_With_A_Much_Longer_Name";
+        destination.bParameter = "Extra_Destination_Blue_Channel_With_A_Much_Longer_Name";
+
+        OscManager oscManager("127.0.0.1", vrchat.GetPort());
+        oscManager.SetExtraDestinations({ destination });
+        oscManager.SetUseBundles(true);
+        oscManager.SetMtu(Mtu);
+
+        std::map<std::string, int> vrchatNames = { { "AL_Red", 0 }, { "AL_Green", 1 }, { "AL_Blue", 2 } };
+        std::map<std::string, int> extraNames = {
+            { destination.rParameter, 0 }, { destination.gParameter, 1 }, { destination.bParameter, 2 }
+        };
+        for (size_t i = 0; i < ZoneCount * 3; i++) {
+            std::string name = "AL_Zone" + std::to_string(i / 3) + "_" + (i % 3 == 0 ? "Red" : (i % 3 == 1 ? "Green" : "Blue"));
+            int id = oscManager.RegisterParameter(name);
+            vrchatNames[name] = id;
+            extraNames[name] = id;
+        }
+
+        size_t count = oscManager.GetParameterCount();
+        std::vector<float> values(count);
+        std::vector<float> expectedValues(count);
+        ValueQuantizer quantizer;
+        for (size_t i = 0; i < count; i++) {
+            values[i] = static_cast<float>(i % 101) / 100.0f;
+            expectedValues[i] = quantizer.Quantize(values[i] * 2.0f - 1.0f);
+        }
+
+        // Everything is new, so every bundle goes to both destinations
+        oscManager.SendValues(values.data(), values.size());
+        std::vector<std::vector<int>> vrchatBundles = ToParameterIds(vrchat.Receive(), vrchatNames, expectedValues);
+        std::vector<std::vector<int>> extraBundles = ToParameterIds(extra.Receive(), extraNames, expectedValues);
+
+        CHECK(vrchatBundles.size() > 1);
+        CHECK(vrchatBundles == extraBundles);
+
+        std::vector<int> received;
+        for (const std::vector<int>& bundle : vrchatBundles) {
+            received.insert(received.end(), bundle.begin(), bundle.end());
+        }
+        CHECK(received.size() == count);
+        for (size_t i = 0; i < received.size(); i++) {
+            CHECK(received[i] == static_cast<int>(i));
+        }
+
+        // With the dead-band on, one changed parameter resends only its bundle, the same one everywhere
+        oscManager.SetDeadBand(true, 0.004f, 60000);
+        for (int changed : { 0, 2, static_cast<int>(count / 2), static_cast<int>(count - 1) }) {
+            values[changed] = values[changed] > 0.5f ? 0.0f : 1.0f;
+            expectedValues[changed] = quantizer.Quantize(values[changed] * 2.0f - 1.0f);
+
+            oscManager.SendValues(values.data(), values.size());
+            std::vector<std::vector<int>> vrchatResent = ToParameterIds(vrchat.Receive(), vrchatNames, expectedValues);
+            std::vector<std::vector<int>> extraResent = ToParameterIds(extra.Receive(), extraNames, expectedValues);
+
+            CHECK_MESSAGE(vrchatResent.size() == 1, "%zu bundles resent for parameter %d", vrchatResent.size(), changed);
+            CHECK(vrchatResent == extraResent);
+            if (!vrchatResent.empty()) {
+                const std::vector<int>& bundle = vrchatResent[0];
+                CHECK(std::find(bundle.begin(), bundle.end(), changed) != bundle.end());
+            }
+        }
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return CheckResult();
+}
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_oscpackettemplate.cpp
+//
+// OscPacketTemplate has to produce exactly the bytes osc::OutboundPacketStream produced for the
+// same messages, which is what every send used to go through. When oscpack is available, single
+// messages, bundles and bundles split at a maximum packet size are encoded both ways and compared
+// byte for byte, for addresses of every length modulo 4 (every amount of string padding).
+// A message and a bundle written out by hand from the OSC 1.0 specification are checked always.
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Check.h"
+#include "OscPacketTemplate.h"
+
+#ifdef AUTOLIGHT_HAS_OSCPACK
+#include <osc/OscOutboundPacketStream.h>
+#endif
+
+static const float SampleValues[] = { 1.0f, -1.0f, 0.0f, -0.0f, 0.5f, 0.333f, -0.999f, 1e-40f };
+static const size_t SampleValueCount = sizeof(SampleValues) / sizeof(SampleValues[0]);
+
+static bool SameBytes(const char* data, size_t size, const std::vector<char>& expected) {
+    return size == expected.size() && std::memcmp(data, expected.data(), size) == 0;
+}
+
+static void CheckSpecificationBytes() {
+    // "/a" padded to 4, ",f" padded to 4, 1.0f big-endian
+    const std::vector<char> message = {
+        '/', 'a', 0, 0, ',', 'f', 0, 0, 0x3F, static_cast<char>(0x80), 0, 0
+    };
+
+    OscPacketTemplate packets;
+    packets.Build({ "/a" }, false);
+    packets.SetValue(0, 1.0f);
+    CHECK(packets.GetPacketCount() == 1);
+    CHECK(SameBytes(packets.GetPacketData(0), packets.GetPacketSize(0), message));
+
+    // "#bundle", the immediate timetag 1, then the message prefixed with its size
+    std::vector<char> bundle = { '#', 'b', 'u', 'n', 'd', 'l', 'e', 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 12 };
+    bundle.insert(bundle.end(), message.begin(), message.end());
+
+    packets.Build({ "/a" }, true);
+    packets.SetValue(0, 1.0f);
+    CHECK(packets.GetPacketCount() == 1);
+    CHECK(SameBytes(packets.GetPacketData(0), packets.GetPacketSize(0), bundle));
+}
+
+#ifdef AUTOLIGHT_HAS_OSCPACK
+
+// Every packet of packets against the same messages serialised by oscpack, grouped into bundles
+// the way the template grouped them
+static void CheckAgainstOscpack(const std::vector<std::string>& addresses, bool bundled, size_t maxPacketSize) {
+    OscPacketTemplate packets;
+    packets.Build(addresses, bundled, maxPacketSize);
+    CHECK(packets.GetMessageCount() == addresses.size());
+
+    std::vector<float> values;
+    for (size_t i = 0; i < addresses.size(); i++) {
+        values.push_back(SampleValues[i % SampleValueCount]);
+        packets.SetValue(i, values.back());
+    }
+
+    std::vector<char> buffer(65536);
+    size_t message = 0;
+    for (size_t packet = 0; packet < packets.GetPacketCount(); packet++) {
+        osc::OutboundPacketStream stream(buffer.data(), buffer.size());
+        if (bundled) {
+            stream << osc::BeginBundleImmediate;
+        }
+        size_t firstMessage = message;
+        while (message < addresses.size() && packets.GetMessagePacket(message) == packet) {
+            stream << osc::BeginMessage(addresses[message].c_str()) << values[message] << osc::EndMessage;
+            message++;
+            if (!bundled) {
+                break;
+            }
+        }
+        if (bundled) {
+            stream << osc::EndBundle;
+        }
+
+        std::vector<char> expected(stream.Data(), stream.Data() + stream.Size());
+        CHECK_MESSAGE(SameBytes(packets.GetPacketData(packet), packets.GetPacketSize(packet), expected),
+            "packet %zu of %zu messages (first \"%s\"), %s, max size %zu: %zu bytes, oscpack %zu",
+            packet, addresses.size(), addresses[0].c_str(), bundled ? "bundled" : "separate", maxPacketSize,
+            packets.GetPacketSize(packet), expected.size());
+        if (bundled && maxPacketSize > 0 && packets.GetPacketSize(packet) > maxPacketSize) {
+            // Only a single message too large on its own may exceed it
+            CHECK(message - firstMessage == 1);
+        }
+    }
+    CHECK(message == addresses.size());
+}
+
+static void CheckOscpackPackets() {
+    // Parameter names of 1 to 12 characters cover every amount of padding three times over
+    for (size_t length = 1; length <= 12; length++) {
+        std::string address = "/avatar/parameters/" + std::string(length, 'x');
+        CheckAgainstOscpack({ address }, false, 0);
+        CheckAgainstOscpack({ address }, true, 0);
+    }
+
+    // A colour update, and a zone grid's worth of parameters with mixed lengths
+    std::vector<std::string> color = {
+        "/avatar/parameters/AL_Red", "/avatar/parameters/AL_Green", "/avatar/parameters/AL_Blue"
+    };
+    CheckAgainstOscpack(color, false, 0);
+    CheckAgainstOscpack(color, true, 0);
+
+    std::vector<std::string> zones;
+    for (int i = 0; i < 48; i++) {
+        std::string prefix = "/avatar/parameters/AL_Zone" + std::to_string(i) + "_";
+        zones.push_back(prefix + "Red");
+        zones.push_back(prefix + "Green");
+        zones.push_back(prefix + "Blue");
+    }
+    for (size_t maxPacketSize : { static_cast<size_t>(0), static_cast<size_t>(1500), static_cast<size_t>(576),
+        static_cast<size_t>(100), static_cast<size_t>(20) }) {
+        CheckAgainstOscpack(zones, true, maxPacketSize);
+    }
+    CheckAgainstOscpack(zones, false, 0);
+}
+
+#endif
+
+int main() {
+    CheckSpecificationBytes();
+#ifdef AUTOLIGHT_HAS_OSCPACK
+    CheckOscpackPackets();
+#else
+    std::printf("oscpack not available, only the specification bytes were checked\n");
+#endif
+    return CheckResult();
+}
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_pixelkernels.cpp
+//
+// The pixel kernels selected for this CPU have to produce exactly what the scalar reference
+// versions produce: for every width up to past two 32-byte vectors, so every tail length is
+// covered, with padded strides and unaligned pointers, and for an all-255 8K frame whose sums
+// overflow 32 bits.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Check.h"
+#include "PixelKernels.h"
+
+static const int MaxWidth = 72;
+
+// Noise everywhere, including the padding and the bytes around the image
+static std::vector<uint8_t> MakeNoise(size_t size, uint32_t seed) {
+    std::vector<uint8_t> data(size);
+    uint32_t state = seed;
+    for (uint8_t& byte : data) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+    return data;
+}
+
+static bool SameSums(const ChannelSums& a, const ChannelSums& b) {
+    return a.c0 == b.c0 && a.c1 == b.c1 && a.c2 == b.c2;
+}
+
+static void CheckSumChannels() {
+    const int heights[] = { 1, 3 };
+    const int paddings[] = { 0, 4, 60 }; // Bytes past the end of every row
+    const int offsets[] = { 0, 1, 3, 4, 17 };
+
+    for (int width = 1; width <= MaxWidth; width++) {
+        for (int height : heights) {
+            for (int padding : paddings) {
+                for (int offset : offsets) {
+                    int stride = width * 4 + padding;
+                    std::vector<uint8_t> buffer = MakeNoise(static_cast<size_t>(stride) * height + offset + 64, width * 131 + padding);
+                    const uint8_t* data = buffer.data() + offset;
+
+                    // Both add to what the sums already hold
+                    ChannelSums expected, actual;
+                    expected.c0 = actual.c0 = 1;
+                    expected.c1 = actual.c1 = 2;
+                    expected.c2 = actual.c2 = 3;
+                    SumChannelsScalar(data, width, height, stride, expected);
+                    SumChannels(data, width, height, stride, actual);
+                    CHECK_MESSAGE(SameSums(expected, actual), "SumChannels %dx%d, stride %d, offset %d", width, height, stride, offset);
+                }
+            }
+        }
+    }
+}
+
+static void CheckSumChannelsWidening() {
+    const int width = 7680;
+    const int height = 4320;
+    std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 4, 255);
+
+    ChannelSums expected, actual;
+    SumChannelsScalar(frame.data(), width, height, width * 4, expected);
+    SumChannels(frame.data(), width, height, width * 4, actual);
+
+    uint64_t full = 255ull * width * height;
+    CHECK(expected.c0 == full && expected.c1 == full && expected.c2 == full);
+    CHECK_MESSAGE(SameSums(expected, actual), "SumChannels all 255 %dx%d: %llu %llu %llu", width, height,
+        static_cast<unsigned long long>(actual.c0), static_cast<unsigned long long>(actual.c1), static_cast<unsigned long long>(actual.c2));
+}
+
+static void CheckShufflePixels() {
+    const uint8_t orders[][4] = { { 0, 1, 2, 3 }, { 2, 1, 0, 3 }, { 3, 2, 1, 0 } };
+    const int offsets[] = { 0, 1, 3, 4 };
+    const int sourceWidth = MaxWidth * 3;
+
+    std::vector<uint8_t> source = MakeNoise(static_cast<size_t>(sourceWidth) * 4 + 64, 7);
+
+    // Decimated and out of order, as the preview's column map can be
+    std::vector<int> columns(MaxWidth);
+    for (int x = 0; x < MaxWidth; x++) {
+        columns[x] = (x * 37 + 5) % sourceWidth;
+    }
+
+    for (const uint8_t* order : orders) {
+        for (int count = 0; count <= MaxWidth; count++) {
+            for (int offset : offsets) {
+                for (bool mapped : { false, true }) {
+                    const uint8_t* row = source.data() + offset;
+                    const int* map = mapped ? columns.data() : nullptr;
+
+                    // Bytes past count pixels must stay as they were
+                    std::vector<uint8_t> expected(static_cast<size_t>(MaxWidth) * 4 + 16, 0xCD);
+                    std::vector<uint8_t> actual(expected.size() + offset, 0xCD);
+                    uint8_t* dst = actual.data() + offset;
+                    ShufflePixelsToRGBAScalar(row, map, count, order, expected.data());
+                    ShufflePixelsToRGBA(row, map, count, order, dst);
+                    CHECK_MESSAGE(std::memcmp(expected.data(), dst, expected.size()) == 0,
+                        "ShufflePixelsToRGBA %d pixels, order %d%d%d%d, offset %d, %s", count,
+                        order[0], order[1], order[2], order[3], offset, mapped ? "column map" : "contiguous");
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    std::printf("Pixel kernels: %s\n", GetPixelKernelName());
+
+    CheckSumChannels();
+    CheckSumChannelsWidening();
+    CheckShufflePixels();
+    return CheckResult();
+}
@@ -0,0 +1,218 @@
+// Copyright (c) 2025 BigSoulja/SouljaVR
+// Developed and maintained by BigSoulja/SouljaVR and all direct or indirect contributors to the GitHub repository.
+// See LICENSE.txt for full copyright and licensing details (GNU General Public License v3.0).
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// This project is open source, but continued development and maintenance benefit from your support.
+// Businesses and collaborators: support via funding, sponsoring, or integration opportunities is welcome.
+// For inquiries or support, please reach out at: Discord: @bigsoulja
+
+
+// test_valuequantizer.cpp
+//
+// ValueQuantizer replaced the original rounding of OSC values,
+//     std::ostringstream out; out << std::fixed << std::setprecision(3) << value; std::stof(out.str())
+// and has to return exactly what it returned for every finite float in [-1, 1], -0 included.
+// The directed rounding modes are checked against the same formatting done under the matching
+// floating-point rounding mode (the C library rounds decimal conversions in the current mode).
+// Ties away from zero has no such mode: it is the nearest result except at exact ties, which are
+// the values whose exact 4-decimal form ends in 5, rounded in the away direction instead.
+//
+// Every float is checked for every mode, over all hardware threads. That is about 2.1 billion
+// floats and takes a while; --stride N only checks every Nth float, for a quick run.
+
+#include <algorithm>
+#include <atomic>
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Check.h"
+#include "ValueQuantizer.h"
+
+#pragma STDC FENV_ACCESS ON
+
+static const uint32_t OneBits = 0x3F800000; // 1.0f
+static const uint32_t SignBit = 0x80000000;
+static const uint32_t ChunkSize = 1 << 20;
+static const uint64_t MaxReportedMismatches = 10;
+
+static float FromBits(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static uint32_t ToBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// The original formatting, in whatever rounding mode is current
+class DecimalFormatter {
+private:
+    std::ostringstream out;
+    std::string text;
+
+public:
+    DecimalFormatter() {
+        out << std::fixed;
+    }
+
+    const std::string& Format(float value, int decimals, int fenvRounding) {
+        std::fesetround(fenvRounding);
+        out.str(std::string());
+        out << std::setprecision(decimals) << value;
+        std::fesetround(FE_TONEAREST);
+
+        text = out.str();
+        return text;
+    }
+};
+
+// The original path, std::stof of the value formatted to 3 decimals, in the given rounding mode
+static float Reference(DecimalFormatter& formatter, float value, RoundingMode mode) {
+    int fenvRounding = FE_TONEAREST;
+    switch (mode) {
+    case RoundingMode::Down: fenvRounding = FE_DOWNWARD; break;
+    case RoundingMode::Up: fenvRounding = FE_UPWARD; break;
+    case RoundingMode::TowardZero: fenvRounding = FE_TOWARDZERO; break;
+    case RoundingMode::NearestAway: {
+        // Rounded to 4 decimals the last digit of a tie is 5 in every mode, and both directions
+        // agree only when the value has an exact 4-decimal form
+        const std::string& nearest4 = formatter.Format(value, 4, FE_TONEAREST);
+        if (nearest4.back() == '5') {
+            std::string down4 = formatter.Format(value, 4, FE_DOWNWARD);
+            if (down4 == formatter.Format(value, 4, FE_UPWARD)) {
+                fenvRounding = std::signbit(value) ? FE_DOWNWARD : FE_UPWARD;
+            }
+        }
+        break;
+    }
+    case RoundingMode::NearestEven:
+    default:
+        break;
+    }
+
+    return std::stof(formatter.Format(value, 3, fenvRounding));
+}
+
+// Whether the C library rounds decimal conversions in the current rounding mode at all
+static bool FormattingFollowsRoundingMode() {
+    DecimalFormatter formatter;
+    return formatter.Format(0.0001f, 3, FE_UPWARD) == "0.001" && formatter.Format(0.0009f, 3, FE_DOWNWARD) == "0.000";
+}
+
+struct ModeResult {
+    std::atomic<uint64_t> checked{ 0 };
+    std::atomic<uint64_t> mismatches{ 0 };
+};
+
+static std::mutex reportMutex;
+
+static void CheckChunks(RoundingMode mode, uint32_t stride, std::atomic<uint32_t>& nextChunk, ModeResult& result) {
+    ValueQuantizer quantizer(1000, mode);
+    DecimalFormatter formatter;
+    uint64_t checked = 0;
+
+    for (;;) {
+        uint32_t first = nextChunk.fetch_add(ChunkSize);
+        if (first > OneBits) {
+            break;
+        }
+        uint32_t last = std::min(first + ChunkSize - 1, OneBits);
+
+        for (uint32_t bits = first; ; bits += stride) {
+            for (uint32_t sign : { 0u, SignBit }) {
+                float value = FromBits(bits | sign);
+                float expected = Reference(formatter, value, mode);
+                float actual = quantizer.Quantize(value);
+                checked++;
+
+                if (ToBits(expected) != ToBits(actual)) {
+                    uint64_t mismatch = result.mismatches.fetch_add(1);
+                    if (mismatch < MaxReportedMismatches) {
+                        std::lock_guard<std::mutex> lock(reportMutex);
+                        std::fprintf(stderr, "%s: %.9g (0x%08x) quantised to %.9g, the original gives %.9g\n",
+                            ValueQuantizer::GetRoundingModeName(mode), value, bits | sign, actual, expected);
+                    }
+                }
+            }
+            if (last - bits < stride) {
+                break;
+            }
+        }
+    }
+    result.checked += checked;
+}
+
+int main(int argc, char** argv) {
+    uint32_t stride = 1;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--stride") == 0) {
+            stride = static_cast<uint32_t>(std::max(1, std::atoi(argv[i + 1])));
+        }
+    }
+
+    // The reference itself: 0.0625 is an exact tie, 0.0626 is not
+    DecimalFormatter formatter;
+    CHECK(Reference(formatter, 0.0625f, RoundingMode::NearestEven) == 0.062f);
+    CHECK(Reference(formatter, 0.0625f, RoundingMode::NearestAway) == 0.063f);
+    CHECK(Reference(formatter, -0.0625f, RoundingMode::NearestAway) == -0.063f);
+    CHECK(Reference(formatter, 0.0626f, RoundingMode::NearestAway) == 0.063f);
+    CHECK(Reference(formatter, 0.0624f, RoundingMode::NearestAway) == 0.062f);
+
+    std::vector<RoundingMode> modes = { RoundingMode::NearestEven, RoundingMode::NearestAway };
+    if (FormattingFollowsRoundingMode()) {
+        modes.insert(modes.end(), { RoundingMode::Down, RoundingMode::Up, RoundingMode::TowardZero });
+    }
+    else {
+        std::printf("The C library ignores the rounding mode when formatting, the directed modes are not checked\n");
+    }
+
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (RoundingMode mode : modes) {
+        ModeResult result;
+        std::atomic<uint32_t> nextChunk{ 0 };
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < threadCount; i++) {
+            threads.emplace_back(CheckChunks, mode, stride, std::ref(nextChunk), std::ref(result));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::printf("%-12s %llu floats, %llu mismatches\n", ValueQuantizer::GetRoundingModeName(mode),
+            static_cast<unsigned long long>(result.checked.load()),
+            static_cast<unsigned long long>(result.mismatches.load()));
+        std::fflush(stdout);
+        CHECK(result.mismatches.load() == 0);
+    }
+
+    // Non-finite values are passed through rather than rounded
+    ValueQuantizer quantizer;
+    CHECK(std::isnan(quantizer.Quantize(FromBits(0x7FC00000))));
+    CHECK(quantizer.Quantize(FromBits(0x7F800000)) == FromBits(0x7F800000));
+
+    return CheckResult();
+}